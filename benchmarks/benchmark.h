@@ -0,0 +1,83 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+//--------------------------------------------------------------
+// Collects the results of each benchmark scenario, which are
+// written as JSON (so they can be tracked release over release)
+// and echoed as they are reported in a human readable form.
+//--------------------------------------------------------------
+class Reporter
+{
+public:
+    using Params = std::vector<std::pair<std::string, double>>;
+
+    explicit Reporter(double a_scale);
+
+    uint64_t Scale(uint64_t a_iterations) const;
+    void Report(const std::string& a_name,
+                const Params& a_params,
+                uint64_t a_operations,
+                std::chrono::nanoseconds a_elapsed);
+    void Write(FILE* a_file) const;
+
+private:
+    struct Result
+    {
+        std::string m_name;
+        Params m_params;
+        uint64_t m_operations;
+        double m_nanoseconds;
+    };
+
+    std::vector<Result> m_results;
+    const double m_scale;
+};
+
+//--------------------------------------------------------------
+// Times a function using the steady clock.
+//--------------------------------------------------------------
+template<class Function>
+std::chrono::nanoseconds Measure(Function&& a_function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    a_function();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+}
+
+//--------------------------------------------------------------
+// Stores a value that benchmarks compute, so that the compiler
+// cannot optimize away the work done by listeners.
+//--------------------------------------------------------------
+void Sink(uint64_t a_value);
+
+//--------------------------------------------------------------
+// Benchmark scenarios, each of which reports one or more results.
+//--------------------------------------------------------------
+void BenchmarkDispatchListeners(Reporter& a_reporter);
+void BenchmarkDispatchPayload(Reporter& a_reporter);
+void BenchmarkDispatchExpired(Reporter& a_reporter);
+void BenchmarkDispatchFilter(Reporter& a_reporter);
+void BenchmarkDispatchRecursive(Reporter& a_reporter);
+void BenchmarkDispatchStatic(Reporter& a_reporter);
+void BenchmarkDispatchBus(Reporter& a_reporter);
+void BenchmarkDispatchThreads(Reporter& a_reporter);
+void BenchmarkRegisterChurn(Reporter& a_reporter);
+void BenchmarkRegisterThreads(Reporter& a_reporter);
+void BenchmarkRegisterGroup(Reporter& a_reporter);
+void BenchmarkQueued(Reporter& a_reporter);
+void BenchmarkTrace(Reporter& a_reporter);
@@ -0,0 +1,383 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include "benchmark.h"
+#include <simple/event/dispatcher.h>
+#include <simple/event/event_bus.h>
+#include <simple/event/static_dispatcher.h>
+#include <array>
+#include <utility>
+#include <vector>
+
+using namespace Simple::Event;
+using namespace std;
+
+//--------------------------------------------------------------
+namespace
+{
+    //----------------------------------------------------------
+    template<size_t Size>
+    struct Payload
+    {
+        array<uint8_t, Size> m_bytes = {};
+    };
+
+    //----------------------------------------------------------
+    template<size_t Size>
+    void BenchmarkPayload(Reporter& a_reporter)
+    {
+        using TestDispatcher = Dispatcher<Payload<Size>>;
+        const uint32_t listenerCount = 10;
+        TestDispatcher dispatcher;
+        uint64_t sum = 0;
+        vector<typename TestDispatcher::Listener> listeners;
+        for (uint32_t i = 0; i < listenerCount; ++i)
+        {
+            listeners.push_back(dispatcher.Register([&sum](const Payload<Size>& a_payload)
+            {
+                sum += a_payload.m_bytes[Size - 1];
+                return Status::Continue;
+            }));
+        }
+
+        Payload<Size> payload;
+        payload.m_bytes[Size - 1] = 1;
+        const uint64_t dispatchCount = a_reporter.Scale(1000000);
+        const chrono::nanoseconds elapsed = Measure([&]()
+        {
+            for (uint64_t i = 0; i < dispatchCount; ++i)
+            {
+                dispatcher.Dispatch(payload);
+            }
+        });
+        a_reporter.Report("dispatch/payload",
+                          { { "bytes", Size }, { "listeners", listenerCount } },
+                          dispatchCount,
+                          elapsed);
+        Sink(sum);
+    }
+
+    //----------------------------------------------------------
+    uint64_t s_staticSum = 0;
+
+    //----------------------------------------------------------
+    Status StaticListenerFunction(const uint64_t& a_value)
+    {
+        s_staticSum += a_value;
+        return Status::Continue;
+    }
+
+    //----------------------------------------------------------
+    template<size_t Index>
+    struct BusEvent
+    {
+        uint64_t m_value = 0;
+    };
+
+    //----------------------------------------------------------
+    template<size_t... Indices>
+    void RegisterBusEvents(EventBus& a_bus,
+                           vector<shared_ptr<void>>& a_listeners,
+                           index_sequence<Indices...>)
+    {
+        (a_listeners.push_back(a_bus.Register<BusEvent<Indices>>([](const BusEvent<Indices>& a_event)
+        {
+            s_staticSum += a_event.m_value;
+            return Status::Continue;
+        })), ...);
+    }
+
+    //----------------------------------------------------------
+    template<class TestDispatcher>
+    Status Recurse(TestDispatcher& a_dispatcher, uint32_t a_depth)
+    {
+        if (a_depth > 0)
+        {
+            a_dispatcher.Dispatch(a_depth - 1);
+        }
+        return Status::Continue;
+    }
+}
+
+//--------------------------------------------------------------
+// Measures the cost of dispatching one event to a dispatcher with
+// an increasing number of listeners (spread over a range of sort
+// indices), which is dominated by iterating the listener storage.
+//--------------------------------------------------------------
+void BenchmarkDispatchListeners(Reporter& a_reporter)
+{
+    using TestDispatcher = Dispatcher<uint64_t>;
+    const uint32_t listenerCounts[] = { 1, 10, 100, 1000, 10000 };
+    const uint64_t listenerCallsPerRun = a_reporter.Scale(10000000);
+
+    for (const uint32_t listenerCount : listenerCounts)
+    {
+        TestDispatcher dispatcher;
+        uint64_t sum = 0;
+        vector<TestDispatcher::Listener> listeners;
+        listeners.reserve(listenerCount);
+        for (uint32_t i = 0; i < listenerCount; ++i)
+        {
+            listeners.push_back(dispatcher.Register([&sum](const uint64_t& a_value)
+            {
+                sum += a_value;
+                return Status::Continue;
+            }, static_cast<int32_t>(i % 16)));
+        }
+
+        // Warm up, then time enough dispatches to be measurable.
+        const uint64_t dispatchCount = max<uint64_t>(1, listenerCallsPerRun / listenerCount);
+        dispatcher.Dispatch(1);
+        const chrono::nanoseconds elapsed = Measure([&]()
+        {
+            for (uint64_t i = 0; i < dispatchCount; ++i)
+            {
+                dispatcher.Dispatch(i);
+            }
+        });
+        a_reporter.Report("dispatch/listeners",
+                          { { "listeners", listenerCount } },
+                          dispatchCount,
+                          elapsed);
+        Sink(sum);
+    }
+}
+
+//--------------------------------------------------------------
+// Measures the cost of dispatching payloads of increasing size,
+// which are passed by reference so should cost the same.
+//--------------------------------------------------------------
+void BenchmarkDispatchPayload(Reporter& a_reporter)
+{
+    BenchmarkPayload<8>(a_reporter);
+    BenchmarkPayload<64>(a_reporter);
+    BenchmarkPayload<512>(a_reporter);
+    BenchmarkPayload<4096>(a_reporter);
+}
+
+//--------------------------------------------------------------
+// Measures the cost of dispatching to a dispatcher where a ratio
+// of the listeners have been released but not yet pruned.
+//--------------------------------------------------------------
+void BenchmarkDispatchExpired(Reporter& a_reporter)
+{
+    using TestDispatcher = Dispatcher<uint64_t>;
+    const uint32_t listenerCount = 1000;
+    const double expiredRatios[] = { 0.0, 0.25, 0.5, 0.9 };
+
+    for (const double expiredRatio : expiredRatios)
+    {
+        TestDispatcher dispatcher;
+        uint64_t sum = 0;
+        vector<TestDispatcher::Listener> listeners;
+        for (uint32_t i = 0; i < listenerCount; ++i)
+        {
+            listeners.push_back(dispatcher.Register([&sum](const uint64_t& a_value)
+            {
+                sum += a_value;
+                return Status::Continue;
+            }));
+        }
+
+        // Release listeners spread evenly through the storage.
+        const uint32_t expiredCount = static_cast<uint32_t>(listenerCount * expiredRatio);
+        for (uint32_t i = 0; i < expiredCount; ++i)
+        {
+            listeners[i * listenerCount / max<uint32_t>(expiredCount, 1)] = nullptr;
+        }
+
+        const uint64_t dispatchCount = a_reporter.Scale(10000);
+        const chrono::nanoseconds elapsed = Measure([&]()
+        {
+            for (uint64_t i = 0; i < dispatchCount; ++i)
+            {
+                dispatcher.Dispatch(i);
+            }
+        });
+        a_reporter.Report("dispatch/expired",
+                          { { "listeners", listenerCount }, { "expired_ratio", expiredRatio } },
+                          dispatchCount,
+                          elapsed);
+        Sink(sum);
+    }
+}
+
+//--------------------------------------------------------------
+// Measures the overhead of wrapping listeners in filters (which
+// pass half of the events), against registering them directly.
+//--------------------------------------------------------------
+void BenchmarkDispatchFilter(Reporter& a_reporter)
+{
+    using TestDispatcher = Dispatcher<uint64_t>;
+    const uint32_t listenerCount = 100;
+
+    for (const bool filtered : { false, true })
+    {
+        TestDispatcher dispatcher;
+        uint64_t sum = 0;
+        vector<TestDispatcher::Listener> listeners;
+        for (uint32_t i = 0; i < listenerCount; ++i)
+        {
+            auto listener = [&sum](const uint64_t& a_value)
+            {
+                sum += a_value;
+                return Status::Continue;
+            };
+            if (filtered)
+            {
+                listeners.push_back(dispatcher.Register(TestDispatcher::Filter([](const uint64_t& a_value)
+                {
+                    return (a_value & 1) == 0;
+                }, listener)));
+            }
+            else
+            {
+                listeners.push_back(dispatcher.Register(listener));
+            }
+        }
+
+        const uint64_t dispatchCount = a_reporter.Scale(100000);
+        const chrono::nanoseconds elapsed = Measure([&]()
+        {
+            for (uint64_t i = 0; i < dispatchCount; ++i)
+            {
+                dispatcher.Dispatch(i);
+            }
+        });
+        a_reporter.Report("dispatch/filter",
+                          { { "listeners", listenerCount }, { "filtered", filtered } },
+                          dispatchCount,
+                          elapsed);
+        Sink(sum);
+    }
+}
+
+//--------------------------------------------------------------
+// Measures the cost of listeners that dispatch again on the same
+// dispatcher, nesting to an increasing depth (each operation is
+// a single dispatch, whether or not it is nested).
+//--------------------------------------------------------------
+void BenchmarkDispatchRecursive(Reporter& a_reporter)
+{
+    using TestDispatcher = Dispatcher<uint32_t>;
+    const uint32_t depths[] = { 0, 1, 2, 4, 8 };
+
+    for (const uint32_t depth : depths)
+    {
+        TestDispatcher dispatcher;
+        TestDispatcher::Listener listener = dispatcher.Register([&dispatcher](const uint32_t& a_depth)
+        {
+            return Recurse(dispatcher, a_depth);
+        });
+
+        const uint64_t dispatchCount = a_reporter.Scale(1000000) / (depth + 1);
+        const chrono::nanoseconds elapsed = Measure([&]()
+        {
+            for (uint64_t i = 0; i < dispatchCount; ++i)
+            {
+                dispatcher.Dispatch(depth);
+            }
+        });
+        a_reporter.Report("dispatch/recursive",
+                          { { "depth", depth } },
+                          dispatchCount * (depth + 1),
+                          elapsed);
+    }
+}
+
+//--------------------------------------------------------------
+// Measures the cost of dispatching to a fixed set of listeners
+// with StaticDispatcher (which can be inlined), against the same
+// listeners registered with a Dispatcher.
+//--------------------------------------------------------------
+void BenchmarkDispatchStatic(Reporter& a_reporter)
+{
+    using TestStaticListener = StaticListener<StaticListenerFunction>;
+    using TestStaticDispatcher = StaticDispatcher<TestStaticListener, TestStaticListener,
+                                                  TestStaticListener, TestStaticListener,
+                                                  TestStaticListener, TestStaticListener,
+                                                  TestStaticListener, TestStaticListener,
+                                                  TestStaticListener, TestStaticListener>;
+    using TestDispatcher = Dispatcher<uint64_t>;
+    const uint32_t listenerCount = 10;
+    const uint64_t dispatchCount = a_reporter.Scale(1000000);
+
+    TestDispatcher dispatcher;
+    vector<TestDispatcher::Listener> listeners;
+    for (uint32_t i = 0; i < listenerCount; ++i)
+    {
+        listeners.push_back(dispatcher.Register(StaticListenerFunction));
+    }
+    a_reporter.Report("dispatch/static",
+                      { { "listeners", listenerCount }, { "static", false } },
+                      dispatchCount,
+                      Measure([&]()
+    {
+        for (uint64_t i = 0; i < dispatchCount; ++i)
+        {
+            dispatcher.Dispatch(i);
+        }
+    }));
+    a_reporter.Report("dispatch/static",
+                      { { "listeners", listenerCount }, { "static", true } },
+                      dispatchCount,
+                      Measure([&]()
+    {
+        for (uint64_t i = 0; i < dispatchCount; ++i)
+        {
+            TestStaticDispatcher::Dispatch(i);
+        }
+    }));
+    Sink(s_staticSum);
+}
+
+//--------------------------------------------------------------
+// Measures the cost of dispatching through an EventBus holding
+// hundreds of event types, against dispatching to the dispatcher
+// of the event type directly.
+//--------------------------------------------------------------
+void BenchmarkDispatchBus(Reporter& a_reporter)
+{
+    using TestEvent = BusEvent<0>;
+    const uint32_t typeCount = 400;
+    const uint64_t dispatchCount = a_reporter.Scale(1000000);
+
+    EventBus bus;
+    vector<shared_ptr<void>> listeners;
+    RegisterBusEvents(bus, listeners, make_index_sequence<typeCount>());
+    Dispatcher<TestEvent> dispatcher;
+    listeners.push_back(dispatcher.Register([](const TestEvent& a_event)
+    {
+        s_staticSum += a_event.m_value;
+        return Status::Continue;
+    }));
+
+    TestEvent event;
+    event.m_value = 1;
+    a_reporter.Report("dispatch/bus",
+                      { { "types", typeCount }, { "bus", false } },
+                      dispatchCount,
+                      Measure([&]()
+    {
+        for (uint64_t i = 0; i < dispatchCount; ++i)
+        {
+            dispatcher.Dispatch(event);
+        }
+    }));
+    a_reporter.Report("dispatch/bus",
+                      { { "types", typeCount }, { "bus", true } },
+                      dispatchCount,
+                      Measure([&]()
+    {
+        for (uint64_t i = 0; i < dispatchCount; ++i)
+        {
+            bus.Dispatch(event);
+        }
+    }));
+    Sink(s_staticSum);
+}
@@ -0,0 +1,85 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include "benchmark.h"
+#include <simple/event/dispatcher.h>
+#include <vector>
+
+using namespace Simple::Event;
+using namespace std;
+
+//--------------------------------------------------------------
+// Measures the cost of delivering a batch of events immediately
+// (one Dispatch per event), against enqueuing all of the events
+// then delivering them with one Flush (into a reserved queue),
+// and against delivering them with DispatchBatch (in each order).
+//--------------------------------------------------------------
+void BenchmarkQueued(Reporter& a_reporter)
+{
+    using TestDispatcher = Dispatcher<uint64_t>;
+    const uint32_t batchSize = 1000;
+    const uint64_t batchCount = a_reporter.Scale(1000);
+    const uint32_t listenerCount = 10;
+
+    TestDispatcher dispatcher;
+    dispatcher.Reserve(batchSize);
+    uint64_t sum = 0;
+    vector<TestDispatcher::Listener> listeners;
+    for (uint32_t i = 0; i < listenerCount; ++i)
+    {
+        listeners.push_back(dispatcher.Register([&sum](const uint64_t& a_value)
+        {
+            sum += a_value;
+            return Status::Continue;
+        }, static_cast<int32_t>(i)));
+    }
+    vector<TestDispatcher::Event> events;
+    for (uint64_t i = 0; i < batchSize; ++i)
+    {
+        events.emplace_back(i);
+    }
+
+    const Reporter::Params params = { { "batch", batchSize }, { "listeners", listenerCount } };
+    const uint64_t eventCount = batchSize * batchCount;
+    a_reporter.Report("queued/dispatch", params, eventCount, Measure([&]()
+    {
+        for (uint64_t batch = 0; batch < batchCount; ++batch)
+        {
+            for (uint64_t i = 0; i < batchSize; ++i)
+            {
+                dispatcher.Dispatch(i);
+            }
+        }
+    }));
+    a_reporter.Report("queued/enqueue_flush", params, eventCount, Measure([&]()
+    {
+        for (uint64_t batch = 0; batch < batchCount; ++batch)
+        {
+            for (uint64_t i = 0; i < batchSize; ++i)
+            {
+                dispatcher.Enqueue(i);
+            }
+            dispatcher.Flush();
+        }
+    }));
+    a_reporter.Report("queued/batch_event_major", params, eventCount, Measure([&]()
+    {
+        for (uint64_t batch = 0; batch < batchCount; ++batch)
+        {
+            dispatcher.DispatchBatch(events, BatchOrder::EventMajor);
+        }
+    }));
+    a_reporter.Report("queued/batch_listener_major", params, eventCount, Measure([&]()
+    {
+        for (uint64_t batch = 0; batch < batchCount; ++batch)
+        {
+            dispatcher.DispatchBatch(events, BatchOrder::ListenerMajor);
+        }
+    }));
+    Sink(sum);
+}
@@ -0,0 +1,210 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include "benchmark.h"
+#include <simple/event/dispatcher.h>
+#include <simple/event/sharded_dispatcher.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Simple::Event;
+using namespace std;
+
+//--------------------------------------------------------------
+namespace
+{
+    //----------------------------------------------------------
+    // Each thread registers then removes listeners with the same
+    // dispatcher, which retains a number of other listeners.
+    template<class TestDispatcher>
+    void RegisterThreads(Reporter& a_reporter,
+                         TestDispatcher& a_dispatcher,
+                         bool a_sharded)
+    {
+        const uint32_t threadCounts[] = { 1, 2, 4, 8, 16, 32 };
+        const uint32_t listenerCount = 1000;
+        auto function = [](const uint64_t&)
+        {
+            return Status::Continue;
+        };
+
+        vector<typename TestDispatcher::Listener> listeners;
+        for (uint32_t i = 0; i < listenerCount; ++i)
+        {
+            listeners.push_back(a_dispatcher.Register(function, static_cast<int32_t>(i % 16)));
+        }
+
+        for (const uint32_t threadCount : threadCounts)
+        {
+            const uint64_t churnCount = a_reporter.Scale(100000) / threadCount;
+            atomic<uint32_t> readyCount = { 0 };
+            atomic<bool> start = { false };
+            vector<thread> threads;
+            for (uint32_t i = 0; i < threadCount; ++i)
+            {
+                threads.emplace_back([&]()
+                {
+                    ++readyCount;
+                    while (!start)
+                    {
+                        this_thread::yield();
+                    }
+                    for (uint64_t j = 0; j < churnCount; ++j)
+                    {
+                        typename TestDispatcher::Connection connection = a_dispatcher.Connect(function, 8);
+                        a_dispatcher.Remove(connection);
+                    }
+                });
+            }
+            while (readyCount < threadCount)
+            {
+                this_thread::yield();
+            }
+
+            const chrono::nanoseconds elapsed = Measure([&]()
+            {
+                start = true;
+                for (thread& thread : threads)
+                {
+                    thread.join();
+                }
+            });
+            a_reporter.Report("register/threads",
+                              { { "threads", threadCount }, { "listeners", listenerCount }, { "sharded", a_sharded } },
+                              churnCount * threadCount,
+                              elapsed);
+        }
+    }
+}
+
+//--------------------------------------------------------------
+// Measures the cost of registering then removing a listener, on
+// a dispatcher that retains an increasing number of listeners
+// (each operation is one registration followed by its removal).
+//--------------------------------------------------------------
+void BenchmarkRegisterChurn(Reporter& a_reporter)
+{
+    using TestDispatcher = Dispatcher<uint64_t>;
+    const uint32_t listenerCounts[] = { 0, 100, 1000, 5000 };
+    auto function = [](const uint64_t&)
+    {
+        return Status::Continue;
+    };
+
+    for (const uint32_t listenerCount : listenerCounts)
+    {
+        TestDispatcher dispatcher;
+        vector<TestDispatcher::Listener> listeners;
+        for (uint32_t i = 0; i < listenerCount; ++i)
+        {
+            listeners.push_back(dispatcher.Register(function, static_cast<int32_t>(i % 16)));
+        }
+
+        for (const bool connect : { false, true })
+        {
+            const uint64_t churnCount = a_reporter.Scale(100000);
+            const chrono::nanoseconds elapsed = Measure([&]()
+            {
+                for (uint64_t i = 0; i < churnCount; ++i)
+                {
+                    if (connect)
+                    {
+                        TestDispatcher::Connection connection = dispatcher.Connect(function, 8);
+                        dispatcher.Remove(connection);
+                    }
+                    else
+                    {
+                        TestDispatcher::Listener listener = dispatcher.Register(function, 8);
+                        dispatcher.Remove(listener);
+                    }
+                }
+            });
+            a_reporter.Report("register/churn",
+                              { { "listeners", listenerCount }, { "connection", connect } },
+                              churnCount,
+                              elapsed);
+        }
+    }
+}
+
+//--------------------------------------------------------------
+// Measures the throughput of an increasing number of threads all
+// registering and removing listeners at once, with a Dispatcher
+// (which every thread contends over) or a ShardedDispatcher (with
+// a shard for each thread), where each result is the wall clock
+// time per registration, across all of the threads.
+//--------------------------------------------------------------
+void BenchmarkRegisterThreads(Reporter& a_reporter)
+{
+    Dispatcher<uint64_t> dispatcher;
+    RegisterThreads(a_reporter, dispatcher, false);
+
+    ShardedDispatcher<uint64_t> sharded(32);
+    RegisterThreads(a_reporter, sharded, true);
+}
+
+//--------------------------------------------------------------
+// Measures the cost of registering then deregistering a screen
+// full of listeners (on a dispatcher that retains others), either
+// one at a time or all at once using RegisterMany and a group
+// (each operation is one listener registered then deregistered).
+//--------------------------------------------------------------
+void BenchmarkRegisterGroup(Reporter& a_reporter)
+{
+    using TestDispatcher = Dispatcher<uint64_t>;
+    const uint32_t groupSizes[] = { 100, 1000, 3000 };
+    const uint32_t listenerCount = 1000;
+    auto function = [](const uint64_t&)
+    {
+        return Status::Continue;
+    };
+
+    TestDispatcher dispatcher;
+    vector<TestDispatcher::Listener> listeners;
+    for (uint32_t i = 0; i < listenerCount; ++i)
+    {
+        listeners.push_back(dispatcher.Register(function, static_cast<int32_t>(i % 16)));
+    }
+
+    for (const uint32_t groupSize : groupSizes)
+    {
+        for (const bool many : { false, true })
+        {
+            const uint64_t repeatCount = a_reporter.Scale(100);
+            const chrono::nanoseconds elapsed = Measure([&]()
+            {
+                for (uint64_t i = 0; i < repeatCount; ++i)
+                {
+                    if (many)
+                    {
+                        TestDispatcher::ListenerGroup group =
+                            dispatcher.RegisterMany(vector<TestDispatcher::Callable>(groupSize, function), 8);
+                    }
+                    else
+                    {
+                        vector<TestDispatcher::Connection> connections;
+                        connections.reserve(groupSize);
+                        for (uint32_t j = 0; j < groupSize; ++j)
+                        {
+                            connections.push_back(dispatcher.Connect(function, 8));
+                        }
+                        for (TestDispatcher::Connection& connection : connections)
+                        {
+                            dispatcher.Remove(connection);
+                        }
+                    }
+                }
+            });
+            a_reporter.Report("register/group",
+                              { { "listeners", listenerCount }, { "group", groupSize }, { "many", many } },
+                              repeatCount * groupSize,
+                              elapsed);
+        }
+    }
+}
@@ -0,0 +1,79 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include "benchmark.h"
+#include <simple/event/dispatcher.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Simple::Event;
+using namespace std;
+
+//--------------------------------------------------------------
+// Measures the throughput of an increasing number of threads all
+// dispatching events to the same dispatcher at once (each result
+// is the wall clock time per event, across all of the threads).
+//--------------------------------------------------------------
+void BenchmarkDispatchThreads(Reporter& a_reporter)
+{
+    using TestDispatcher = Dispatcher<uint64_t>;
+    const uint32_t threadCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+    const uint32_t listenerCount = 10;
+
+    TestDispatcher dispatcher;
+    vector<TestDispatcher::Listener> listeners;
+    for (uint32_t i = 0; i < listenerCount; ++i)
+    {
+        listeners.push_back(dispatcher.Register([](const uint64_t& a_value)
+        {
+            // Listeners are shared by threads, so only read state.
+            return (a_value == UINT64_MAX) ? Status::Consumed : Status::Continue;
+        }));
+    }
+
+    for (const uint32_t threadCount : threadCounts)
+    {
+        const uint64_t dispatchCount = a_reporter.Scale(1000000) / threadCount;
+        atomic<uint32_t> readyCount = { 0 };
+        atomic<bool> start = { false };
+        vector<thread> threads;
+        for (uint32_t i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([&]()
+            {
+                ++readyCount;
+                while (!start)
+                {
+                    this_thread::yield();
+                }
+                for (uint64_t event = 0; event < dispatchCount; ++event)
+                {
+                    dispatcher.Dispatch(event);
+                }
+            });
+        }
+        while (readyCount < threadCount)
+        {
+            this_thread::yield();
+        }
+
+        const chrono::nanoseconds elapsed = Measure([&]()
+        {
+            start = true;
+            for (thread& thread : threads)
+            {
+                thread.join();
+            }
+        });
+        a_reporter.Report("dispatch/threads",
+                          { { "threads", threadCount }, { "listeners", listenerCount } },
+                          dispatchCount * threadCount,
+                          elapsed);
+    }
+}
@@ -0,0 +1,70 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include "benchmark.h"
+#include <simple/event/trace.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace Simple::Event;
+using namespace std;
+
+//--------------------------------------------------------------
+// Measures the cost of recording events to a trace file, against
+// dispatching them directly, and of replaying the trace (as fast
+// as possible) through the same dispatcher.
+//--------------------------------------------------------------
+void BenchmarkTrace(Reporter& a_reporter)
+{
+    using TestDispatcher = Dispatcher<uint64_t>;
+    const uint64_t eventCount = a_reporter.Scale(1000000);
+    const uint32_t listenerCount = 10;
+    const string path = (filesystem::temp_directory_path() / "simple_event_benchmark.trace").string();
+
+    TestDispatcher dispatcher;
+    uint64_t sum = 0;
+    vector<TestDispatcher::Listener> listeners;
+    for (uint32_t i = 0; i < listenerCount; ++i)
+    {
+        listeners.push_back(dispatcher.Register([&sum](const uint64_t& a_value)
+        {
+            sum += a_value;
+            return Status::Continue;
+        }, static_cast<int32_t>(i)));
+    }
+
+    const Reporter::Params params = { { "listeners", listenerCount } };
+    a_reporter.Report("trace/dispatch", params, eventCount, Measure([&]()
+    {
+        for (uint64_t i = 0; i < eventCount; ++i)
+        {
+            dispatcher.Dispatch(i);
+        }
+    }));
+    {
+        Recorder<uint64_t> recorder(dispatcher, path);
+        a_reporter.Report("trace/record", params, eventCount, Measure([&]()
+        {
+            for (uint64_t i = 0; i < eventCount; ++i)
+            {
+                recorder.Dispatch(i);
+            }
+            recorder.Flush();
+        }));
+    }
+    {
+        const Replayer<uint64_t> replayer(path);
+        a_reporter.Report("trace/replay", params, eventCount, Measure([&]()
+        {
+            Sink(replayer.Replay(dispatcher));
+        }));
+    }
+    filesystem::remove(path);
+    Sink(sum);
+}
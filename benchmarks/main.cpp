@@ -0,0 +1,170 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include "benchmark.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+using namespace std;
+
+#ifndef SIMPLE_EVENT_VERSION
+#define SIMPLE_EVENT_VERSION "unknown"
+#endif
+
+//--------------------------------------------------------------
+namespace
+{
+    atomic<uint64_t> s_sink = { 0 };
+
+    //----------------------------------------------------------
+    struct Scenario
+    {
+        const char* m_name;
+        void (*m_function)(Reporter&);
+    };
+
+    //----------------------------------------------------------
+    const Scenario s_scenarios[] =
+    {
+        { "dispatch/listeners", BenchmarkDispatchListeners },
+        { "dispatch/payload", BenchmarkDispatchPayload },
+        { "dispatch/expired", BenchmarkDispatchExpired },
+        { "dispatch/filter", BenchmarkDispatchFilter },
+        { "dispatch/recursive", BenchmarkDispatchRecursive },
+        { "dispatch/static", BenchmarkDispatchStatic },
+        { "dispatch/bus", BenchmarkDispatchBus },
+        { "dispatch/threads", BenchmarkDispatchThreads },
+        { "register/churn", BenchmarkRegisterChurn },
+        { "register/threads", BenchmarkRegisterThreads },
+        { "register/group", BenchmarkRegisterGroup },
+        { "queued", BenchmarkQueued },
+        { "trace", BenchmarkTrace }
+    };
+}
+
+//--------------------------------------------------------------
+Reporter::Reporter(double a_scale)
+    : m_scale(a_scale)
+{
+}
+
+//--------------------------------------------------------------
+uint64_t Reporter::Scale(uint64_t a_iterations) const
+{
+    return max<uint64_t>(1, static_cast<uint64_t>(static_cast<double>(a_iterations) * m_scale));
+}
+
+//--------------------------------------------------------------
+void Reporter::Report(const string& a_name,
+                      const Params& a_params,
+                      uint64_t a_operations,
+                      chrono::nanoseconds a_elapsed)
+{
+    const double nanoseconds = static_cast<double>(a_elapsed.count());
+    m_results.push_back({ a_name, a_params, a_operations, nanoseconds });
+
+    fprintf(stderr, "%-28s", a_name.c_str());
+    for (const pair<string, double>& param : a_params)
+    {
+        fprintf(stderr, " %s=%g", param.first.c_str(), param.second);
+    }
+    fprintf(stderr, " : %.3f ns/op\n", nanoseconds / static_cast<double>(a_operations));
+}
+
+//--------------------------------------------------------------
+void Reporter::Write(FILE* a_file) const
+{
+    fprintf(a_file, "{\n");
+    fprintf(a_file, "  \"library\": \"simple_event\",\n");
+    fprintf(a_file, "  \"version\": \"%s\",\n", SIMPLE_EVENT_VERSION);
+#if defined(NDEBUG)
+    fprintf(a_file, "  \"optimized\": true,\n");
+#else
+    fprintf(a_file, "  \"optimized\": false,\n");
+#endif
+    fprintf(a_file, "  \"scale\": %g,\n", m_scale);
+    fprintf(a_file, "  \"results\": [");
+    for (size_t i = 0; i < m_results.size(); ++i)
+    {
+        const Result& result = m_results[i];
+        fprintf(a_file, "%s\n    {\"name\": \"%s\", \"params\": {",
+                i ? "," : "", result.m_name.c_str());
+        for (size_t j = 0; j < result.m_params.size(); ++j)
+        {
+            fprintf(a_file, "%s\"%s\": %g", j ? ", " : "",
+                    result.m_params[j].first.c_str(),
+                    result.m_params[j].second);
+        }
+        fprintf(a_file, "}, \"operations\": %llu, \"ns_total\": %.0f, \"ns_per_op\": %.4f}",
+                static_cast<unsigned long long>(result.m_operations),
+                result.m_nanoseconds,
+                result.m_nanoseconds / static_cast<double>(result.m_operations));
+    }
+    fprintf(a_file, "\n  ]\n}\n");
+}
+
+//--------------------------------------------------------------
+void Sink(uint64_t a_value)
+{
+    s_sink.fetch_add(a_value, memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+// Runs every benchmark scenario (or those whose names start with
+// the --filter argument), writing the results as JSON to stdout
+// or to the --output file. Pass --quick to run fewer iterations.
+//--------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    double scale = 1.0;
+    const char* filter = "";
+    const char* output = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--quick") == 0)
+        {
+            scale = 0.01;
+        }
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+        {
+            filter = argv[++i];
+        }
+        else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+        {
+            output = argv[++i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--quick] [--filter prefix] [--output file]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Reporter reporter(scale);
+    for (const Scenario& scenario : s_scenarios)
+    {
+        if (strncmp(scenario.m_name, filter, strlen(filter)) == 0)
+        {
+            scenario.m_function(reporter);
+        }
+    }
+
+    FILE* file = output ? fopen(output, "w") : stdout;
+    if (!file)
+    {
+        fprintf(stderr, "failed to open %s\n", output);
+        return 1;
+    }
+    reporter.Write(file);
+    if (file != stdout)
+    {
+        fclose(file);
+    }
+    return 0;
+}
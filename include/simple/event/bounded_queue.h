@@ -0,0 +1,308 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Event
+{
+
+//--------------------------------------------------------------
+//! What a BoundedQueue does when an item is pushed while full.
+//--------------------------------------------------------------
+enum class Overflow
+{
+    Fail = 0, //!< Reject the new item, and return false.
+    Block = 1, //!< Wait (spinning) until there is space for it.
+    DropOldest = 2, //!< Discard the oldest item, to make space.
+    DropNewest = 3 //!< Discard the new item, and count it dropped.
+};
+
+//--------------------------------------------------------------
+//! Template class that implements a bounded lock-free queue, so
+//! any number of threads can push items without taking a lock or
+//! allocating memory (eg. audio or render threads posting events
+//! for the main loop to dispatch, see Dispatcher::Drain).
+//!
+//! Each slot of the ring buffer records a sequence number, which
+//! tells producers and consumers whether it is free or full, so a
+//! push or pop is a single compare-and-swap on the tail or head.
+//! By default only one thread may pop items at a time, in which
+//! case popping needs no compare-and-swap at all (unless oldest
+//! items are dropped, as producers then pop them too).
+//!
+//! \tparam Type Type of the items that are stored in the queue.
+//! \tparam MultiConsumer Whether several threads may pop items.
+//--------------------------------------------------------------
+template<class Type, bool MultiConsumer = false>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(size_t a_capacity,
+                          Overflow a_overflow = Overflow::Fail);
+    ~BoundedQueue();
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    template<class... Params>
+    bool Emplace(Params&&... a_params);
+    bool Push(Type a_item);
+    std::optional<Type> Pop();
+
+    size_t Capacity() const;
+    size_t DroppedCount() const;
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> m_sequence;
+        alignas(Type) unsigned char m_storage[sizeof(Type)];
+    };
+
+    static size_t RoundUp(size_t a_capacity);
+    Slot* Claim();
+
+    const std::unique_ptr<Slot[]> m_slots;
+    const size_t m_mask;
+    const Overflow m_overflow;
+    alignas(64) std::atomic<size_t> m_tail = { 0 };
+    alignas(64) std::atomic<size_t> m_head = { 0 };
+    alignas(64) std::atomic<size_t> m_droppedCount = { 0 };
+};
+
+//--------------------------------------------------------------
+//! Allocates the ring buffer, rounding its capacity up to the next
+//! power of two. This is the only time the queue allocates memory.
+//!
+//! \param[in] a_capacity Minimum number of items that can be queued.
+//! \param[in] a_overflow What to do when pushing onto a full queue.
+//--------------------------------------------------------------
+template<class Type, bool MultiConsumer> inline
+BoundedQueue<Type, MultiConsumer>::BoundedQueue(size_t a_capacity,
+                                                Overflow a_overflow)
+    : m_slots(new Slot[RoundUp(a_capacity)])
+    , m_mask(RoundUp(a_capacity) - 1)
+    , m_overflow(a_overflow)
+{
+    for (size_t i = 0; i <= m_mask; ++i)
+    {
+        m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+//--------------------------------------------------------------
+//! Destroys any items that remain in the queue.
+//--------------------------------------------------------------
+template<class Type, bool MultiConsumer> inline
+BoundedQueue<Type, MultiConsumer>::~BoundedQueue()
+{
+    while (Pop())
+    {
+    }
+}
+
+//--------------------------------------------------------------
+//! Constructs an item at the back of the queue, from parameters.
+//! Can be called concurrently by any number of threads.
+//!
+//! \param[in] a_params Parameters used to construct the item.
+//! \return True if the item was queued, or false if the queue was
+//!         full and the item was rejected (or dropped).
+//--------------------------------------------------------------
+template<class Type, bool MultiConsumer>
+template<class... Params> inline
+bool BoundedQueue<Type, MultiConsumer>::Emplace(Params&&... a_params)
+{
+    Slot* slot = Claim();
+    while (!slot)
+    {
+        switch (m_overflow)
+        {
+            case Overflow::Block:
+            {
+                std::this_thread::yield();
+                break;
+            }
+            case Overflow::DropOldest:
+            {
+                if (Pop())
+                {
+                    m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                }
+                break;
+            }
+            case Overflow::DropNewest:
+            {
+                m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            case Overflow::Fail:
+            default:
+            {
+                return false;
+            }
+        }
+        slot = Claim();
+    }
+
+    // Construct the item, then hand the slot over to consumers.
+    const size_t sequence = slot->m_sequence.load(std::memory_order_relaxed);
+    new (slot->m_storage) Type(std::forward<Params>(a_params)...);
+    slot->m_sequence.store(sequence + 1, std::memory_order_release);
+    return true;
+}
+
+//--------------------------------------------------------------
+//! Moves an item to the back of the queue.
+//!
+//! \param[in] a_item Item to queue.
+//! \return True if the item was queued, or false if the queue was
+//!         full and the item was rejected (or dropped).
+//--------------------------------------------------------------
+template<class Type, bool MultiConsumer> inline
+bool BoundedQueue<Type, MultiConsumer>::Push(Type a_item)
+{
+    return Emplace(std::move(a_item));
+}
+
+//--------------------------------------------------------------
+//! Maximum number of items that can be queued at once.
+//!
+//! \return Capacity of the ring buffer.
+//--------------------------------------------------------------
+template<class Type, bool MultiConsumer> inline
+size_t BoundedQueue<Type, MultiConsumer>::Capacity() const
+{
+    return m_mask + 1;
+}
+
+//--------------------------------------------------------------
+//! Number of items dropped (by DropOldest or DropNewest) so far.
+//!
+//! \return Number of items that were discarded when full.
+//--------------------------------------------------------------
+template<class Type, bool MultiConsumer> inline
+size_t BoundedQueue<Type, MultiConsumer>::DroppedCount() const
+{
+    return m_droppedCount.load(std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+//! Rounds a capacity up to a power of two (of at least two), so
+//! slots can be indexed by masking the head or tail position.
+//!
+//! \param[in] a_capacity Minimum number of items to be queued.
+//! \return Capacity of the ring buffer.
+//--------------------------------------------------------------
+template<class Type, bool MultiConsumer> inline
+size_t BoundedQueue<Type, MultiConsumer>::RoundUp(size_t a_capacity)
+{
+    size_t capacity = 2;
+    while (capacity < a_capacity)
+    {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+//--------------------------------------------------------------
+//! Claims the slot at the back of the queue for this producer.
+//!
+//! \return Slot to construct the item in, or null if queue full.
+//--------------------------------------------------------------
+template<class Type, bool MultiConsumer> inline
+typename BoundedQueue<Type, MultiConsumer>::Slot*
+BoundedQueue<Type, MultiConsumer>::Claim()
+{
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    while (true)
+    {
+        // The slot is free once its sequence reaches the tail.
+        Slot* slot = &m_slots[tail & m_mask];
+        const size_t sequence = slot->m_sequence.load(std::memory_order_acquire);
+        const ptrdiff_t difference = static_cast<ptrdiff_t>(sequence - tail);
+        if (difference == 0)
+        {
+            if (m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+            {
+                return slot;
+            }
+        }
+        else if (difference < 0)
+        {
+            return nullptr;
+        }
+        else
+        {
+            tail = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+//--------------------------------------------------------------
+//! Removes the item at the front of the queue, if there is one.
+//! Unless the queue is multi-consumer, only one thread at a time
+//! may call this.
+//!
+//! \return The item that was removed, or empty if none are queued.
+//--------------------------------------------------------------
+template<class Type, bool MultiConsumer> inline
+std::optional<Type> BoundedQueue<Type, MultiConsumer>::Pop()
+{
+    const bool contended = MultiConsumer || m_overflow == Overflow::DropOldest;
+    size_t head = m_head.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while (true)
+    {
+        // The slot is full once its sequence passes the head.
+        slot = &m_slots[head & m_mask];
+        const size_t sequence = slot->m_sequence.load(std::memory_order_acquire);
+        const ptrdiff_t difference = static_cast<ptrdiff_t>(sequence - (head + 1));
+        if (difference == 0)
+        {
+            if (!contended)
+            {
+                m_head.store(head + 1, std::memory_order_relaxed);
+                break;
+            }
+            if (m_head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            return std::nullopt;
+        }
+        else
+        {
+            head = m_head.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Move the item out, then hand the slot back to producers.
+    Type* item = std::launder(reinterpret_cast<Type*>(slot->m_storage));
+    std::optional<Type> result(std::move(*item));
+    item->~Type();
+    slot->m_sequence.store(head + m_mask + 1, std::memory_order_release);
+    return result;
+}
+
+} // namespace Event
+} // namespace Simple
@@ -0,0 +1,154 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Event
+{
+
+//--------------------------------------------------------------
+//! Exception thrown when dispatches are nested deeper than the
+//! limit (see DispatchDepth::SetLimit), eg. by listeners that keep
+//! dispatching events which end up invoking themselves again.
+//--------------------------------------------------------------
+class DispatchDepthExceeded : public std::runtime_error
+{
+public:
+    explicit DispatchDepthExceeded(size_t a_limit);
+};
+
+//--------------------------------------------------------------
+//! Guard that counts how deeply dispatches are nested (by listeners
+//! that dispatch events themselves) on the calling thread, across
+//! all dispatchers, and fails loudly once the depth limit is passed
+//! rather than letting runaway recursion overflow the stack.
+//!
+//! Nested dispatches do not allocate memory once the thread has a
+//! hazard pointer for each level (which are reused after that), so
+//! call HazardPointer::Reserve on a thread to preallocate them.
+//--------------------------------------------------------------
+class DispatchDepth
+{
+public:
+    DispatchDepth();
+    ~DispatchDepth();
+
+    DispatchDepth(const DispatchDepth&) = delete;
+    DispatchDepth& operator=(const DispatchDepth&) = delete;
+
+    static size_t Current();
+    static size_t Limit();
+    static void SetLimit(size_t a_limit);
+
+private:
+    static size_t& ThreadDepth();
+    static std::atomic<size_t>& MaxDepth();
+};
+
+//--------------------------------------------------------------
+//! Creates the exception, with a message that includes the limit.
+//!
+//! \param[in] a_limit Depth limit that was exceeded.
+//--------------------------------------------------------------
+inline DispatchDepthExceeded::DispatchDepthExceeded(size_t a_limit)
+    : std::runtime_error("Dispatch nested deeper than the limit of " +
+                         std::to_string(a_limit))
+{
+}
+
+//--------------------------------------------------------------
+//! Enters a dispatch, nested within any that the calling thread
+//! is already in the middle of.
+//!
+//! \throw DispatchDepthExceeded if nested deeper than the limit.
+//--------------------------------------------------------------
+inline DispatchDepth::DispatchDepth()
+{
+    size_t& depth = ThreadDepth();
+    const size_t limit = Limit();
+    if (depth >= limit)
+    {
+        throw DispatchDepthExceeded(limit);
+    }
+    ++depth;
+}
+
+//--------------------------------------------------------------
+//! Leaves the dispatch.
+//--------------------------------------------------------------
+inline DispatchDepth::~DispatchDepth()
+{
+    --ThreadDepth();
+}
+
+//--------------------------------------------------------------
+//! Number of dispatches that the calling thread is in the middle
+//! of (zero when not called from within a listener).
+//!
+//! \return Depth of nested dispatches on the calling thread.
+//--------------------------------------------------------------
+inline size_t DispatchDepth::Current()
+{
+    return ThreadDepth();
+}
+
+//--------------------------------------------------------------
+//! Maximum number of dispatches that may be nested on a thread.
+//!
+//! \return Depth limit, which is 256 by default.
+//--------------------------------------------------------------
+inline size_t DispatchDepth::Limit()
+{
+    return MaxDepth().load(std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+//! Sets the maximum number of dispatches that may be nested on a
+//! thread, beyond which DispatchDepthExceeded is thrown. Applies
+//! to all threads, and should be low enough to not overflow their
+//! stacks (taking into account what listeners put on the stack).
+//!
+//! \param[in] a_limit Depth limit (at least 1).
+//--------------------------------------------------------------
+inline void DispatchDepth::SetLimit(size_t a_limit)
+{
+    MaxDepth().store(a_limit > 0 ? a_limit : 1, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+//! Depth of nested dispatches on the calling thread.
+//!
+//! \return Reference to the depth of the calling thread.
+//--------------------------------------------------------------
+inline size_t& DispatchDepth::ThreadDepth()
+{
+    static thread_local size_t s_depth = 0;
+    return s_depth;
+}
+
+//--------------------------------------------------------------
+//! Depth limit shared by all threads.
+//!
+//! \return Reference to the depth limit.
+//--------------------------------------------------------------
+inline std::atomic<size_t>& DispatchDepth::MaxDepth()
+{
+    static std::atomic<size_t> s_maxDepth = { 256 };
+    return s_maxDepth;
+}
+
+} // namespace Event
+} // namespace Simple
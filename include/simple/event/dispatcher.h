@@ -8,11 +8,24 @@
 
 #pragma once
 
+#include <simple/event/bounded_queue.h>
+#include <simple/event/dispatch_depth.h>
+#include <simple/event/executor.h>
+#include <simple/event/inplace_function.h>
+#include <simple/event/locking.h>
+#include <simple/event/statistics.h>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
-#include <map>
+#include <limits>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 //--------------------------------------------------------------
@@ -32,33 +45,252 @@ enum class Status
     Filtered = 2 //!< Listener filtered, keep dispatching event.
 };
 
+//--------------------------------------------------------------
+//! Order in which a batch of events is delivered to listeners.
+//--------------------------------------------------------------
+enum class BatchOrder
+{
+    EventMajor = 0, //!< Each event is sent to all listeners in turn.
+    ListenerMajor = 1 //!< Each listener is sent all events in turn.
+};
+
+//--------------------------------------------------------------
+//! Policy used by Dispatcher, which stores callables and filter
+//! functions as std::function objects (these can heap allocate),
+//! and is thread safe (see MutexLocking). Policies that define no
+//! Locking model also use MutexLocking.
+//--------------------------------------------------------------
+struct DefaultPolicy
+{
+    template<class Signature>
+    using Function = std::function<Signature>;
+    using Locking = MutexLocking;
+};
+
+//--------------------------------------------------------------
+//! Policy that stores callables and filter functions inline, in
+//! InplaceFunction objects which never allocate memory. Typical
+//! lambdas (eg. capturing one or two pointers) fit the default.
+//!
+//! \tparam Capacity Size in bytes of the inline callable storage.
+//--------------------------------------------------------------
+template<size_t Capacity = 4 * sizeof(void*)>
+struct InplacePolicy : DefaultPolicy
+{
+    template<class Signature>
+    using Function = InplaceFunction<Signature, Capacity>;
+};
+
+//--------------------------------------------------------------
+//! Policy that stores callables and filter functions inline, in
+//! move-only InplaceFunction objects, so lambdas capturing move-
+//! only objects (eg. std::unique_ptr) can also be registered.
+//!
+//! \tparam Capacity Size in bytes of the inline callable storage.
+//--------------------------------------------------------------
+template<size_t Capacity = 4 * sizeof(void*)>
+struct MoveOnlyPolicy : DefaultPolicy
+{
+    template<class Signature>
+    using Function = InplaceFunction<Signature, Capacity, false>;
+};
+
+//--------------------------------------------------------------
+//! Policy that adds instrumentation to another policy, so that the
+//! dispatcher records statistics for itself and for each listener
+//! (see BasicDispatcher::Statistics). Dispatchers instantiated with
+//! any other policy compile all of the instrumentation away.
+//!
+//! \tparam Base Policy that defines how callables are stored.
+//--------------------------------------------------------------
+template<class Base = DefaultPolicy>
+struct InstrumentedPolicy : Base
+{
+    static constexpr bool Instrumented = true;
+};
+
+//--------------------------------------------------------------
+//! Policy that makes another policy single threaded, for the many
+//! dispatchers only ever used by one thread (at a time), so that
+//! registering, removing and queuing listeners locks no mutex, and
+//! dispatching reads the listeners directly (see NoLocking).
+//! DispatchAsync and DispatchParallel are not available.
+//!
+//! \tparam Base Policy that defines how callables are stored.
+//--------------------------------------------------------------
+template<class Base = DefaultPolicy>
+struct SingleThreadedPolicy : Base
+{
+    using Locking = NoLocking;
+};
+
+//--------------------------------------------------------------
+//! Policy that makes concurrent dispatches of another policy share
+//! a reader/writer lock (see SharedMutexLocking), rather than each
+//! protecting the listeners with a hazard pointer.
+//!
+//! \tparam Base Policy that defines how callables are stored.
+//--------------------------------------------------------------
+template<class Base = DefaultPolicy>
+struct SharedMutexPolicy : Base
+{
+    using Locking = SharedMutexLocking;
+};
+
+template<class Policy, class... Args>
+class BasicDispatcher;
+template<class Policy, class Key, class... Args>
+class BasicKeyedDispatcher;
+template<class Policy, class... Args>
+class BasicShardedDispatcher;
+template<class Policy, class... Args>
+class BasicRecorder;
+
+//--------------------------------------------------------------
+//! Completion objects are lightweight handles returned by the
+//! Dispatcher::DispatchAsync function, which can be queried (or
+//! waited on) to find out whether the event has been delivered,
+//! and whether a listener consumed it. Copies share their state.
+//!
+//! An empty (default constructed) completion is always complete,
+//! and never consumed. Listeners must not wait on completions of
+//! events that are delivered by the executor invoking them, as it
+//! may have no other threads available to deliver those events.
+//--------------------------------------------------------------
+class Completion
+{
+public:
+    Completion() = default;
+
+    explicit operator bool() const noexcept;
+    bool Ready() const;
+    void Wait() const;
+    bool Consumed() const;
+
+private:
+    template<class Policy, class... Args>
+    friend class BasicDispatcher;
+
+    struct State
+    {
+        void Complete(bool a_consumed);
+
+        std::mutex m_mutex;
+        std::condition_variable m_completed;
+        std::atomic<bool> m_ready = { false };
+        bool m_consumed = false;
+    };
+
+    explicit Completion(std::shared_ptr<State> a_state);
+
+    std::shared_ptr<State> m_state;
+};
+
 //--------------------------------------------------------------
 //! Template class that maintains a collection of event listener
 //! functions that are invoked each time the event is dispatched.
 //!
+//! Event arguments are passed by const reference all the way from
+//! Dispatch to every listener and filter, so each event payload is
+//! constructed once and never copied, allowing move-only or even
+//! non-copyable argument types. Listener functions may still take
+//! arguments by value, in which case only they pay for the copy.
+//! Reference arguments (eg. Dispatcher<int&>) remain non-const.
+//!
+//! The type used to store callables is defined by a policy, so
+//! it can be replaced (eg. by InplacePolicy or MoveOnlyPolicy) by
+//! instantiating BasicDispatcher directly, rather than Dispatcher.
+//! The policy also defines how the dispatcher is locked, so those
+//! only used by one thread can lock nothing (SingleThreadedPolicy).
+//!
+//! Registered callables are either retained by a Listener (which
+//! is a shared pointer) or by a Connection (which is move-only and
+//! avoids the allocation of a shared pointer control block); both
+//! deregister the callable when they are released or destroyed.
+//!
+//! All memory the dispatcher allocates (listener entries, shared
+//! pointer control blocks, snapshots of listeners, queued events
+//! and scratch space) comes from the memory resource it is given,
+//! which must outlive the dispatcher and all of its listeners. The
+//! exception is state shared with executor tasks (by DispatchAsync
+//! and DispatchParallel), which may outlive the dispatch itself.
+//!
+//! \tparam Policy Class that defines how callables are stored.
 //! \tparam Args Parameter pack that defines the event signature.
 //--------------------------------------------------------------
-template<class... Args>
-class Dispatcher
+template<class Policy, class... Args>
+class BasicDispatcher
 {
 public:
-    using Callable = std::function<Status(Args...)>;
-    using Listener = std::shared_ptr<Callable>;
+    using Callable = typename Policy::template Function<Status(const Args&...)>;
+    class Connection;
+    class Registration;
+    class ListenerGroup;
+    class Cursor;
+    using Listener = std::shared_ptr<Registration>;
+
+    explicit BasicDispatcher(std::pmr::memory_resource* a_resource = std::pmr::get_default_resource());
+    ~BasicDispatcher();
 
     [[nodiscard]]
-    Listener Register(const Callable& a_callable,
+    Listener Register(Callable a_callable,
                       const int32_t& a_sortIndex = 0);
     bool Remove(const Listener& a_listener);
 
-    void Dispatch(Args... a_args);
+    [[nodiscard]]
+    Connection Connect(Callable a_callable,
+                       const int32_t& a_sortIndex = 0);
+    bool Remove(const Connection& a_connection);
+
+    [[nodiscard]]
+    ListenerGroup RegisterMany(std::vector<Callable> a_callables,
+                               const int32_t& a_sortIndex = 0);
+
+    size_t Compact();
+    size_t ExpiredCount() const;
+    void SetAutoCompact(bool a_autoCompact);
+
+    void Dispatch(const Args&... a_args);
+
+    using Event = std::tuple<typename std::decay<Args>::type...>;
+    Cursor DispatchFor(std::chrono::nanoseconds a_budget,
+                       const Args&... a_args);
+    bool Resume(Cursor& a_cursor,
+                std::chrono::nanoseconds a_budget);
+
+    void Reserve(size_t a_capacity);
+    void Enqueue(const Args&... a_args);
+    size_t Process(size_t a_maxEvents);
+    size_t Flush();
+
+    void DispatchBatch(const Event* a_events,
+                       size_t a_count,
+                       BatchOrder a_order = BatchOrder::EventMajor);
+    void DispatchBatch(const std::vector<Event>& a_events,
+                       BatchOrder a_order = BatchOrder::EventMajor);
+
+    template<bool MultiConsumer>
+    size_t Drain(BoundedQueue<Event, MultiConsumer>& a_queue,
+                 size_t a_maxEvents = std::numeric_limits<size_t>::max());
+
+    Completion DispatchAsync(const Args&... a_args);
+    Completion DispatchAsync(Executor& a_executor,
+                             const Args&... a_args);
+
+    void DispatchParallel(const Args&... a_args);
+    void DispatchParallel(Executor& a_executor,
+                          const Args&... a_args);
+
+    DispatcherStatistics Statistics() const;
+    std::vector<ListenerStatistics> CollectListenerStatistics() const;
 
     class Filter
     {
     public:
-        using Function = std::function<bool(Args...)>;
-        Filter(const Function& a_function,
-               const Callable& a_callable);
-        Status operator()(Args...) const;
+        using Function = typename Policy::template Function<bool(const Args&...)>;
+        Filter(Function a_function,
+               Callable a_callable);
+        Status operator()(const Args&...) const;
 
     private:
         Function m_function;
@@ -66,10 +298,299 @@ public:
     };
 
 private:
-    std::multimap<int32_t, std::weak_ptr<Callable>> m_listeners;
-    std::mutex m_listenersMutex;
+    template<class OtherPolicy, class Key, class... OtherArgs>
+    friend class BasicKeyedDispatcher;
+    template<class OtherPolicy, class... OtherArgs>
+    friend class BasicShardedDispatcher;
+    template<class OtherPolicy, class... OtherArgs>
+    friend class BasicRecorder;
+
+    template<class Type, class = void>
+    struct IsInstrumented : std::false_type {};
+    template<class Type>
+    struct IsInstrumented<Type, typename std::enable_if<Type::Instrumented>::type> : std::true_type {};
+    static constexpr bool Instrumented = IsInstrumented<Policy>::value;
+
+    template<class Type, class = void>
+    struct LockingOf { using type = MutexLocking; };
+    template<class Type>
+    struct LockingOf<Type, std::void_t<typename Type::Locking>> { using type = typename Type::Locking; };
+    using Locking = typename LockingOf<Policy>::type;
+    using Mutex = typename Locking::Mutex;
+
+    struct alignas(64) ListenerCounters
+    {
+        void Record(Status a_status,
+                    std::chrono::nanoseconds a_time) const;
+        ListenerStatistics Load(const int32_t& a_sortIndex) const;
+
+        mutable std::atomic<uint64_t> m_invocations = { 0 };
+        mutable std::atomic<uint64_t> m_statuses[3] = {};
+        mutable std::atomic<int64_t> m_totalTime = { 0 };
+        mutable std::atomic<int64_t> m_maxTime = { 0 };
+    };
+
+    struct DispatcherCounters
+    {
+        StripedCounter m_dispatches;
+        StripedCounter m_lockWaitTime;
+        std::atomic<uint64_t> m_prunedListeners = { 0 };
+    };
+
+    struct NoCounters {};
+
+    struct Entry : std::conditional<Instrumented, ListenerCounters, NoCounters>::type
+    {
+        Entry(std::pmr::memory_resource* a_resource,
+              Callable&& a_callable,
+              const int32_t& a_sortIndex);
+        static Entry* Create(std::pmr::memory_resource* a_resource,
+                             Callable&& a_callable,
+                             const int32_t& a_sortIndex);
+        bool Expired(const uint64_t& a_epoch) const;
+        bool Expire();
+        bool Expire(const uint64_t& a_epoch);
+        void Retain();
+        void Release();
+
+        std::pmr::memory_resource* const m_resource;
+        Callable m_callable;
+        std::atomic<uint64_t> m_expiredEpoch;
+        std::atomic<uint32_t> m_references;
+        const int32_t m_sortIndex;
+        uint64_t m_sequence = 0;
+    };
+
+    struct Snapshot
+    {
+        explicit Snapshot(std::pmr::memory_resource* a_resource);
+        ~Snapshot();
+        static Snapshot* Create(std::pmr::memory_resource* a_resource);
+        static void Destroy(Snapshot* a_snapshot);
+        std::pmr::vector<Entry*> m_entries;
+    };
+
+    struct AsyncEvent : Completion::State
+    {
+        AsyncEvent(BasicDispatcher* a_dispatcher,
+                   const Args&... a_args);
+
+        BasicDispatcher* const m_dispatcher;
+        const Event m_event;
+    };
+
+    struct ParallelBand
+    {
+        ParallelBand(Entry* const* a_entries,
+                     size_t a_count,
+                     const uint64_t& a_epoch,
+                     const std::tuple<const Args&...>* a_args);
+        void Run();
+        void Wait();
+
+        Entry* const* const m_entries;
+        const size_t m_count;
+        const uint64_t m_epoch;
+        const std::tuple<const Args&...>* const m_args;
+        std::atomic<size_t> m_next = { 0 };
+        std::atomic<size_t> m_done = { 0 };
+        std::atomic<bool> m_consumed = { false };
+        std::mutex m_mutex;
+        std::condition_variable m_completed;
+    };
+
+    static std::atomic<uint64_t>& ExpiryEpoch();
+    static std::atomic<uint64_t>& RegistrationSequence();
+    static Status Call(const Entry& a_entry,
+                       const Args&... a_args);
+    static bool Invoke(const Snapshot& a_snapshot,
+                       const uint64_t& a_epoch,
+                       const Args&... a_args);
+    static void InvokeBatch(const Snapshot& a_snapshot,
+                            const Event* a_events,
+                            size_t a_count,
+                            BatchOrder a_order);
+    void Grow(size_t a_capacity);
+    size_t Publish(Entry* const* a_entries = nullptr,
+                   size_t a_count = 0);
+    void CountExpired(size_t a_count);
+    std::unique_lock<Mutex> Lock(Mutex& a_mutex);
+    void CountDispatches(size_t a_count);
+
+    std::pmr::memory_resource* const m_resource;
+    typename std::conditional<Instrumented, DispatcherCounters, NoCounters>::type m_counters;
+    std::atomic<Snapshot*> m_listeners = { nullptr };
+    std::pmr::vector<Snapshot*> m_retired;
+    mutable typename Locking::Readers m_readers;
+    Mutex m_listenersMutex;
+    size_t m_expiredCount = 0;
+    bool m_autoCompact = true;
+
+    std::pmr::vector<std::optional<Event>> m_queue;
+    std::pmr::vector<Event> m_processing;
+    size_t m_queueFront = 0;
+    size_t m_queueSize = 0;
+    Mutex m_queueMutex;
+    Mutex m_processMutex;
+};
+
+//--------------------------------------------------------------
+//! Dispatcher that stores callables using the default policy.
+//!
+//! \tparam Args Parameter pack that defines the event signature.
+//--------------------------------------------------------------
+template<class... Args>
+using Dispatcher = BasicDispatcher<DefaultPolicy, Args...>;
+
+//--------------------------------------------------------------
+//! Connection objects are move-only handles returned by Connect,
+//! which hold an intrusive reference to the registered callable
+//! (and record the dispatcher it was registered with so that it
+//! can be removed in constant time). Destroying or disconnecting
+//! the connection deregisters the callable, just like releasing
+//! all references to a listener, without needing an allocation.
+//--------------------------------------------------------------
+template<class Policy, class... Args>
+class BasicDispatcher<Policy, Args...>::Connection
+{
+public:
+    Connection() = default;
+    Connection(Connection&& a_other) noexcept;
+    Connection& operator=(Connection&& a_other) noexcept;
+    ~Connection();
+
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    explicit operator bool() const noexcept;
+    Status operator()(const Args&... a_args) const;
+    void Disconnect();
+
+    ListenerStatistics Statistics() const;
+
+private:
+    friend class BasicDispatcher;
+    friend class ListenerGroup;
+    Connection(Entry* a_entry,
+               const BasicDispatcher* a_dispatcher);
+
+    Entry* m_entry = nullptr;
+    const BasicDispatcher* m_dispatcher = nullptr;
+};
+
+//--------------------------------------------------------------
+//! Registration objects are the handles returned (wrapped in a
+//! Listener) by Dispatcher::Register, which share the connection
+//! to a registered callable between all references to a listener.
+//--------------------------------------------------------------
+template<class Policy, class... Args>
+class BasicDispatcher<Policy, Args...>::Registration
+{
+public:
+    explicit Registration(Connection&& a_connection);
+
+    Status operator()(const Args&... a_args) const;
+
+    ListenerStatistics Statistics() const;
+
+private:
+    friend class BasicDispatcher;
+
+    const Connection m_connection;
+};
+
+//--------------------------------------------------------------
+//! ListenerGroup objects are move-only handles returned by
+//! RegisterMany, which own the connections of many callables (eg.
+//! all those registered by one screen of a UI), and deregister all
+//! of them in a single pass when cleared or destroyed, compacting
+//! the listeners (at most) once rather than for each listener.
+//! Groups must be cleared (or destroyed) before their dispatcher.
+//--------------------------------------------------------------
+template<class Policy, class... Args>
+class BasicDispatcher<Policy, Args...>::ListenerGroup
+{
+public:
+    ListenerGroup() = default;
+    explicit ListenerGroup(BasicDispatcher& a_dispatcher);
+    ListenerGroup(ListenerGroup&& a_other) noexcept;
+    ListenerGroup& operator=(ListenerGroup&& a_other) noexcept;
+    ~ListenerGroup();
+
+    ListenerGroup(const ListenerGroup&) = delete;
+    ListenerGroup& operator=(const ListenerGroup&) = delete;
+
+    bool Add(Connection&& a_connection);
+    void Clear();
+    size_t Size() const;
+
+private:
+    friend class BasicDispatcher;
+
+    std::pmr::vector<Entry*> m_entries;
+    BasicDispatcher* m_dispatcher = nullptr;
+};
+
+//--------------------------------------------------------------
+//! Cursor objects are returned by Dispatcher::DispatchFor, which
+//! hold a copy of an event along with the position of the next
+//! listener to deliver it to, so that a dispatch which ran out of
+//! time can be resumed (by Dispatcher::Resume) in a later call.
+//! Cursors do not reference any listeners, so they can be kept (or
+//! dropped, abandoning the rest of the dispatch) for any length of
+//! time, but must only be resumed by the dispatcher that made them.
+//--------------------------------------------------------------
+template<class Policy, class... Args>
+class BasicDispatcher<Policy, Args...>::Cursor
+{
+public:
+    bool Done() const;
+    bool Consumed() const;
+
+private:
+    friend class BasicDispatcher;
+    Cursor(uint64_t a_endSequence,
+           const Args&... a_args);
+
+    Event m_event;
+    uint64_t m_endSequence;
+    uint64_t m_nextSequence = 0;
+    int32_t m_nextSortIndex = std::numeric_limits<int32_t>::min();
+    bool m_done = false;
+    bool m_consumed = false;
 };
 
+//--------------------------------------------------------------
+//! Creates a dispatcher that allocates memory from a resource, eg.
+//! a PoolResource, or a std::pmr::monotonic_buffer_resource.
+//!
+//! \param[in] a_resource Memory resource to allocate memory from.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::BasicDispatcher(std::pmr::memory_resource* a_resource)
+    : m_resource(a_resource)
+    , m_retired(a_resource)
+    , m_queue(a_resource)
+    , m_processing(a_resource)
+{
+}
+
+//--------------------------------------------------------------
+//! Destroys the dispatcher, which must not be dispatching events.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::~BasicDispatcher()
+{
+    if (Snapshot* snapshot = m_listeners.load(std::memory_order_relaxed))
+    {
+        Snapshot::Destroy(snapshot);
+    }
+    for (Snapshot* snapshot : m_retired)
+    {
+        Snapshot::Destroy(snapshot);
+    }
+}
+
 //--------------------------------------------------------------
 //! Registers a callable to invoke when each event is dispatched.
 //!
@@ -78,17 +599,15 @@ private:
 //! \return Listener to retain while callable should be invoked.
 //!         Release all references to 'deregister' the callable.
 //--------------------------------------------------------------
-template<class... Args> inline
-typename Dispatcher<Args...>::Listener
-Dispatcher<Args...>::Register(const Callable& a_callable,
-                              const int32_t& a_sortIndex)
+template<class Policy, class... Args> inline
+typename BasicDispatcher<Policy, Args...>::Listener
+BasicDispatcher<Policy, Args...>::Register(Callable a_callable,
+                                           const int32_t& a_sortIndex)
 {
-    // Create the listener and add it to the container.
-    std::lock_guard<std::mutex> lock(m_listenersMutex);
-    Listener listener = std::make_shared<Callable>(a_callable);
-    m_listeners.emplace(std::make_pair(a_sortIndex, listener));
-
-    return listener;
+    // Share the connection, which expires once it is released.
+    return std::allocate_shared<Registration>(std::pmr::polymorphic_allocator<Registration>(m_resource),
+                                              Connect(std::move(a_callable),
+                                                      a_sortIndex));
 }
 
 //--------------------------------------------------------------
@@ -97,99 +616,1707 @@ Dispatcher<Args...>::Register(const Callable& a_callable,
 //! \param[in] a_listener Listener object to stop being invoked.
 //! \return True if the listener was removed or false otherwise.
 //--------------------------------------------------------------
-template<class... Args> inline
-bool Dispatcher<Args...>::Remove(const Listener& a_listener)
+template<class Policy, class... Args> inline
+bool BasicDispatcher<Policy, Args...>::Remove(const Listener& a_listener)
+{
+    return a_listener && Remove(a_listener->m_connection);
+}
+
+//--------------------------------------------------------------
+//! Registers a callable to invoke when each event is dispatched.
+//!
+//! \param[in] a_callable A callable object that will be invoked.
+//! \param[in] a_sortIndex Order in which to invoke the callable.
+//! \return Connection to retain while callable should be invoked.
+//!         Destroy or disconnect it to 'deregister' the callable.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+typename BasicDispatcher<Policy, Args...>::Connection
+BasicDispatcher<Policy, Args...>::Connect(Callable a_callable,
+                                          const int32_t& a_sortIndex)
+{
+    // Create the entry, which is referenced by the connection and
+    // by each snapshot of listeners that it is published in.
+    Connection connection(Entry::Create(m_resource, std::move(a_callable), a_sortIndex),
+                          this);
+
+    // Add the entry to the container and publish the change,
+    // numbering it in the order that entries are added.
+    std::unique_lock<Mutex> lock = Lock(m_listenersMutex);
+    connection.m_entry->m_sequence = RegistrationSequence().fetch_add(1, std::memory_order_relaxed);
+    Publish(&connection.m_entry, 1);
+
+    return connection;
+}
+
+//--------------------------------------------------------------
+//! Remove a connection so not invoked when events are dispatched.
+//!
+//! The connection records where it was registered, so it is found
+//! and expired in constant time. Expired listeners are compacted
+//! once they outnumber those still registered, so the amortized
+//! cost of removal does not depend on the number of listeners
+//! (unless disabled by SetAutoCompact, see Compact).
+//!
+//! \param[in] a_connection Connection object to stop being invoked.
+//! \return True if the connection was removed or false otherwise.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+bool BasicDispatcher<Policy, Args...>::Remove(const Connection& a_connection)
 {
-    // Find and remove the listener from the container.
-    std::lock_guard<std::mutex> lock(m_listenersMutex);
-    const auto& listenersBegin = m_listeners.begin();
-    const auto& listenersEnd = m_listeners.end();
-    for (auto it = listenersBegin; it != listenersEnd; ++it)
+    // Expire the entry if it was registered with this dispatcher.
+    if (!a_connection ||
+        a_connection.m_dispatcher != this ||
+        !a_connection.m_entry->Expire())
     {
-        if (it->second.lock() == a_listener)
-        {
-            m_listeners.erase(it);
-            return true;
-        }
+        return false;
     }
-    return false;
+    CountExpired(1);
+    return true;
 }
 
 //--------------------------------------------------------------
-//! Sequentially dispatches an event to all registered listeners.
-//! If a listener returns Status::Consumed the dispatch will end,
-//! and no remaining (lower priority) listeners shall be invoked.
+//! Registers many callables at once (eg. all of those for one
+//! screen of a UI), which are all inserted into the listeners with
+//! a single lock of the mutex and rebuild of the listeners, rather
+//! than one of each for every callable.
 //!
-//! \param[in] a_args Arguments forwarded to each event listener.
+//! \param[in] a_callables Callable objects that will be invoked,
+//!            in the order that they are to be invoked.
+//! \param[in] a_sortIndex Order in which to invoke the callables.
+//! \return Group to retain while callables should be invoked.
+//!         Destroy or clear it to 'deregister' all the callables.
 //--------------------------------------------------------------
-template<class... Args> inline
-void Dispatcher<Args...>::Dispatch(Args... a_args)
+template<class Policy, class... Args> inline
+typename BasicDispatcher<Policy, Args...>::ListenerGroup
+BasicDispatcher<Policy, Args...>::RegisterMany(std::vector<Callable> a_callables,
+                                               const int32_t& a_sortIndex)
 {
-    // Gather non-expired listeners.
-    std::vector<Listener> listeners;
+    // Create the entries, which are referenced by the group and
+    // by each snapshot of listeners that they are published in.
+    ListenerGroup group(*this);
+    group.m_entries.reserve(a_callables.size());
+    for (Callable& callable : a_callables)
+    {
+        group.m_entries.push_back(Entry::Create(m_resource, std::move(callable), a_sortIndex));
+    }
+    if (group.m_entries.empty())
     {
-        std::lock_guard<std::mutex> lock(m_listenersMutex);
-        listeners.reserve(m_listeners.size());
+        return group;
+    }
 
-        // Iterate over all listeners.
-        auto it = m_listeners.begin();
-        while (it != m_listeners.end())
-        {
-            if (Listener listener = it->second.lock())
-            {
-                // Copy non-expired listeners.
-                listeners.push_back(listener);
-                ++it;
-            }
-            else
-            {
-                // Prune expired listeners.
-                it = m_listeners.erase(it);
-            }
-        }
+    // Add the entries to the container and publish the change,
+    // numbering them in the order that entries are added.
+    std::unique_lock<Mutex> lock = Lock(m_listenersMutex);
+    const uint64_t sequence = RegistrationSequence().fetch_add(group.m_entries.size(),
+                                                               std::memory_order_relaxed);
+    for (size_t i = 0; i < group.m_entries.size(); ++i)
+    {
+        group.m_entries[i]->m_sequence = sequence + i;
     }
+    Publish(group.m_entries.data(), group.m_entries.size());
+
+    return group;
+}
 
-    // Send the event to each listener.
-    for (Listener listener : listeners)
+//--------------------------------------------------------------
+//! Prunes all expired listeners now, publishing a compacted array
+//! of listeners, and frees retired snapshots (along with listeners
+//! they alone still reference) that are no longer being dispatched.
+//!
+//! Dispatching skips expired listeners without freeing them, so
+//! call this from an idle or maintenance thread (eg. after a scene
+//! is unloaded) to keep that work off threads that dispatch events.
+//! Must not be called by listeners.
+//!
+//! \return Number of expired listeners that were pruned.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+size_t BasicDispatcher<Policy, Args...>::Compact()
+{
+    std::unique_lock<Mutex> lock = Lock(m_listenersMutex);
+    const Snapshot* snapshot = m_listeners.load(std::memory_order_relaxed);
+    const bool expired = snapshot &&
+        std::any_of(snapshot->m_entries.begin(), snapshot->m_entries.end(),
+                    [](const Entry* a_entry)
     {
-        if (Callable callable = *listener)
-        {
-            Status status = callable(a_args...);
-            if (status == Status::Consumed)
-            {
-                // Stop sending the event.
-                break;
-            }
-        }
+        return a_entry->m_expiredEpoch.load(std::memory_order_acquire) != 0;
+    });
+    if (!expired)
+    {
+        Locking::Reclaim(m_readers, m_retired, Snapshot::Destroy);
+        return 0;
     }
+    return Publish();
 }
 
 //--------------------------------------------------------------
-//! Filter objects are essentially event listeners that are only
-//! invoked if a filter function with the same args returns true.
+//! Counts the listeners that have expired (by being removed, or by
+//! releasing all references to them) but have not yet been pruned,
+//! which can be used to decide when to call Compact.
 //!
-//! \param[in] a_function Function to filter all incoming events.
-//! \param[in] a_callable Callable to be invoked unless filtered.
+//! \return Number of expired listeners waiting to be pruned.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+size_t BasicDispatcher<Policy, Args...>::ExpiredCount() const
+{
+    typename Locking::ReadGuard readGuard(m_readers);
+    const Snapshot* snapshot = readGuard.Protect(m_listeners);
+    if (!snapshot)
+    {
+        return 0;
+    }
+    return static_cast<size_t>(std::count_if(snapshot->m_entries.begin(),
+                                             snapshot->m_entries.end(),
+                                             [](const Entry* a_entry)
+    {
+        return a_entry->m_expiredEpoch.load(std::memory_order_acquire) != 0;
+    }));
+}
+
+//--------------------------------------------------------------
+//! Sets whether Remove compacts the listeners automatically, once
+//! expired listeners outnumber those still registered (the default).
+//! Disable it to leave all pruning to Compact, so that removing a
+//! listener never rebuilds or frees anything on the calling thread.
+//!
+//! \param[in] a_autoCompact Whether to compact listeners in Remove.
 //--------------------------------------------------------------
-template<class... Args> inline
-Dispatcher<Args...>::Filter::Filter(const Function& a_function,
-                                    const Callable& a_callable)
-    : m_function(a_function)
-    , m_callable(a_callable)
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::SetAutoCompact(bool a_autoCompact)
 {
+    std::unique_lock<Mutex> lock = Lock(m_listenersMutex);
+    m_autoCompact = a_autoCompact;
 }
 
 //--------------------------------------------------------------
-//! Function call operator which allows the filter object to be
-//! registered directly with an event dispatcher as a callable.
+//! Sequentially dispatches an event to all registered listeners.
+//! If a listener returns Status::Consumed the dispatch will end,
+//! and no remaining (lower priority) listeners shall be invoked.
 //!
-//! \param[in] a_args Arguments forwarded to filter and callable.
+//! Listeners are read from an immutable snapshot that is guarded
+//! by a hazard pointer (by default, see MutexLocking), so
+//! dispatching never locks the listeners mutex, allocates memory,
+//! or modifies any reference count, and concurrent dispatches do
+//! not contend over shared cache lines.
+//! Listeners released during a dispatch are still invoked by it,
+//! and listeners registered during a dispatch are not. Callables
+//! are invoked in place, with no copies or reference counting.
+//! Listeners may dispatch events themselves, up to a depth limit.
+//!
+//! \param[in] a_args Arguments passed by reference to listeners.
+//! \throw DispatchDepthExceeded if nested deeper than the limit.
 //--------------------------------------------------------------
-template<class... Args> inline
-Status Dispatcher<Args...>::Filter::operator()(Args... a_args) const
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::Dispatch(const Args&... a_args)
 {
-    return (m_callable && m_function && m_function(a_args...)) ?
-            m_callable(a_args...) : Status::Filtered;
+    const DispatchDepth depth;
+
+    // Grab the current snapshot without locking the mutex.
+    const uint64_t epoch = ExpiryEpoch().load(std::memory_order_acquire);
+    typename Locking::ReadGuard readGuard(m_readers);
+    const Snapshot* snapshot = readGuard.Protect(m_listeners);
+    if (snapshot)
+    {
+        Invoke(*snapshot, epoch, a_args...);
+    }
+    CountDispatches(1);
+}
+
+//--------------------------------------------------------------
+//! Dispatches an event to registered listeners in priority order
+//! (exactly as Dispatch would) until a time budget runs out, then
+//! returns a cursor that Resume can use to deliver the event to the
+//! remaining listeners later (eg. in the slack of the next frame).
+//! At least one listener is invoked, so every call makes progress,
+//! and the clock is checked after each listener (which cannot be
+//! interrupted, so slow listeners can still overrun the budget).
+//!
+//! The arguments are copied into the cursor. If a listener returns
+//! Status::Consumed the dispatch is done, and no remaining (lower
+//! priority) listeners are invoked when it is resumed. Listeners
+//! registered after the dispatch began are never invoked by it,
+//! and listeners removed before it is resumed are skipped.
+//!
+//! \param[in] a_budget Time to spend invoking listeners.
+//! \param[in] a_args Arguments copied then passed to listeners.
+//! \return Cursor to resume the dispatch from (which may be done).
+//! \throw DispatchDepthExceeded if nested deeper than the limit.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+typename BasicDispatcher<Policy, Args...>::Cursor
+BasicDispatcher<Policy, Args...>::DispatchFor(std::chrono::nanoseconds a_budget,
+                                              const Args&... a_args)
+{
+    Cursor cursor(RegistrationSequence().load(std::memory_order_acquire), a_args...);
+    Resume(cursor, a_budget);
+    return cursor;
+}
+
+//--------------------------------------------------------------
+//! Resumes a dispatch started by DispatchFor, delivering its event
+//! to the remaining listeners in priority order until the time
+//! budget runs out again (invoking at least one listener). Finding
+//! where to resume from is a binary search of the listeners, so it
+//! does not depend on how many listeners were already invoked.
+//!
+//! \param[in] a_cursor Cursor returned by DispatchFor.
+//! \param[in] a_budget Time to spend invoking listeners.
+//! \return True if the dispatch is done, or false if it must be
+//!         resumed again to deliver the event to all listeners.
+//! \throw DispatchDepthExceeded if nested deeper than the limit.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+bool BasicDispatcher<Policy, Args...>::Resume(Cursor& a_cursor,
+                                              std::chrono::nanoseconds a_budget)
+{
+    if (a_cursor.m_done)
+    {
+        return true;
+    }
+    const DispatchDepth depth;
+
+    // Grab the current snapshot, then find the next listener in it.
+    const auto deadline = std::chrono::steady_clock::now() + a_budget;
+    const uint64_t epoch = ExpiryEpoch().load(std::memory_order_acquire);
+    typename Locking::ReadGuard readGuard(m_readers);
+    const Snapshot* snapshot = readGuard.Protect(m_listeners);
+    if (snapshot)
+    {
+        const std::pmr::vector<Entry*>& entries = snapshot->m_entries;
+        auto next = std::lower_bound(entries.begin(), entries.end(), a_cursor,
+                                     [](const Entry* a_entry, const Cursor& a_position)
+        {
+            return a_entry->m_sortIndex != a_position.m_nextSortIndex ?
+                   a_entry->m_sortIndex < a_position.m_nextSortIndex :
+                   a_entry->m_sequence < a_position.m_nextSequence;
+        });
+        for (; next != entries.end(); ++next)
+        {
+            const Entry* entry = *next;
+            if (entry->m_sequence >= a_cursor.m_endSequence ||
+                entry->Expired(epoch) || !entry->m_callable)
+            {
+                continue;
+            }
+            const Status status = std::apply([entry](auto&... a_args)
+            {
+                return Call(*entry, a_args...);
+            }, a_cursor.m_event);
+            if (status == Status::Consumed)
+            {
+                // Stop sending the event.
+                a_cursor.m_consumed = true;
+                break;
+            }
+            a_cursor.m_nextSortIndex = entry->m_sortIndex;
+            a_cursor.m_nextSequence = entry->m_sequence + 1;
+            if (std::next(next) != entries.end() &&
+                std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+        }
+    }
+    a_cursor.m_done = true;
+    CountDispatches(1);
+    return true;
+}
+
+//--------------------------------------------------------------
+//! Pre-sizes the ring buffer that stores queued events, so that
+//! enqueuing (or processing) up to this many events at a time
+//! does not allocate memory. Must not be called by listeners.
+//!
+//! \param[in] a_capacity Number of events that can be queued.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::Reserve(size_t a_capacity)
+{
+    std::unique_lock<Mutex> processLock = Lock(m_processMutex);
+    m_processing.reserve(a_capacity);
+
+    std::unique_lock<Mutex> queueLock = Lock(m_queueMutex);
+    if (a_capacity > m_queue.size())
+    {
+        Grow(a_capacity);
+    }
+}
+
+//--------------------------------------------------------------
+//! Queues an event to be dispatched to all registered listeners
+//! by the next call to Flush (or Process), without invoking any
+//! listener on the calling thread. The arguments are copied into
+//! a ring buffer, which only allocates memory if it is full (it
+//! doubles in size), so call Reserve up front to avoid that.
+//!
+//! \param[in] a_args Arguments copied then passed to listeners.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::Enqueue(const Args&... a_args)
+{
+    std::unique_lock<Mutex> lock = Lock(m_queueMutex);
+    if (m_queueSize == m_queue.size())
+    {
+        Grow(m_queue.empty() ? 16 : m_queue.size() * 2);
+    }
+    const size_t back = (m_queueFront + m_queueSize) % m_queue.size();
+    m_queue[back].emplace(a_args...);
+    ++m_queueSize;
+}
+
+//--------------------------------------------------------------
+//! Dispatches queued events, in the order they were enqueued, to
+//! all registered listeners, using a single snapshot of listeners
+//! for every event (so listeners registered while processing only
+//! receive subsequent events). Listeners released while processing
+//! are not invoked for any remaining events. If a listener returns
+//! Status::Consumed only the event being dispatched is consumed.
+//!
+//! Events enqueued while processing (eg. by listeners) are left
+//! for the next call. Calls are serialized with one another, and
+//! listeners must not process events of their own dispatcher.
+//!
+//! \param[in] a_maxEvents Maximum number of events to dispatch.
+//! \return Number of queued events that were dispatched.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+size_t BasicDispatcher<Policy, Args...>::Process(size_t a_maxEvents)
+{
+    std::unique_lock<Mutex> processLock = Lock(m_processMutex);
+
+    // Move the events out of the queue, so producers are only
+    // blocked for as long as it takes to move the events.
+    {
+        std::unique_lock<Mutex> queueLock = Lock(m_queueMutex);
+        const size_t count = std::min(a_maxEvents, m_queueSize);
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::optional<Event>& event = m_queue[m_queueFront];
+            m_processing.push_back(std::move(*event));
+            event.reset();
+            m_queueFront = (m_queueFront + 1) % m_queue.size();
+        }
+        m_queueSize -= count;
+    }
+
+    // Grab the current snapshot once, then dispatch every event.
+    typename Locking::ReadGuard readGuard(m_readers);
+    const Snapshot* snapshot = readGuard.Protect(m_listeners);
+    const size_t count = m_processing.size();
+    if (snapshot)
+    {
+        InvokeBatch(*snapshot,
+                    m_processing.data(),
+                    count,
+                    BatchOrder::EventMajor);
+    }
+    m_processing.clear();
+    CountDispatches(count);
+    return count;
+}
+
+//--------------------------------------------------------------
+//! Dispatches all queued events to all registered listeners.
+//!
+//! \return Number of queued events that were dispatched.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+size_t BasicDispatcher<Policy, Args...>::Flush()
+{
+    return Process(std::numeric_limits<size_t>::max());
+}
+
+//--------------------------------------------------------------
+//! Dispatches a contiguous batch of events to all registered
+//! listeners, using a single snapshot of listeners for the whole
+//! batch (so listeners registered during the batch do not receive
+//! any of its events). If a listener returns Status::Consumed then
+//! only that event is consumed; the remaining (lower priority)
+//! listeners are not sent it, but are still sent other events.
+//!
+//! With BatchOrder::EventMajor events are delivered exactly as if
+//! dispatched one by one. With BatchOrder::ListenerMajor each
+//! listener is instead sent every (unconsumed) event back to back,
+//! keeping its code and data hot, so listeners must not depend on
+//! the interleaving of events across different listeners. Either
+//! way, every event reaches listeners in the order of the batch.
+//!
+//! \param[in] a_events Pointer to the first event in the batch.
+//! \param[in] a_count Number of events in the batch.
+//! \param[in] a_order Order in which to deliver the events.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::DispatchBatch(const Event* a_events,
+                                                     size_t a_count,
+                                                     BatchOrder a_order)
+{
+    const DispatchDepth depth;
+
+    // Grab the current snapshot once, then dispatch every event.
+    typename Locking::ReadGuard readGuard(m_readers);
+    const Snapshot* snapshot = readGuard.Protect(m_listeners);
+    if (snapshot)
+    {
+        InvokeBatch(*snapshot, a_events, a_count, a_order);
+    }
+    CountDispatches(a_count);
+}
+
+//--------------------------------------------------------------
+//! Dispatches a batch of events to all registered listeners.
+//!
+//! \param[in] a_events Events to dispatch, in order.
+//! \param[in] a_order Order in which to deliver the events.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::DispatchBatch(const std::vector<Event>& a_events,
+                                                     BatchOrder a_order)
+{
+    DispatchBatch(a_events.data(), a_events.size(), a_order);
+}
+
+//--------------------------------------------------------------
+//! Pops events from a lock-free queue (that any thread may push
+//! events onto without locking, eg. by calling a_queue.Emplace
+//! with the event arguments) and dispatches them in order to all
+//! registered listeners, using a single snapshot of listeners for
+//! every event, just like Process does for events that were queued
+//! with Enqueue. Only the consumer(s) of the queue may call this.
+//!
+//! \param[in] a_queue Queue of events to dispatch.
+//! \param[in] a_maxEvents Maximum number of events to dispatch.
+//! \return Number of queued events that were dispatched.
+//--------------------------------------------------------------
+template<class Policy, class... Args>
+template<bool MultiConsumer> inline
+size_t BasicDispatcher<Policy, Args...>::Drain(BoundedQueue<Event, MultiConsumer>& a_queue,
+                                               size_t a_maxEvents)
+{
+    // Grab the current snapshot once, then dispatch every event.
+    typename Locking::ReadGuard readGuard(m_readers);
+    const Snapshot* snapshot = readGuard.Protect(m_listeners);
+    size_t count = 0;
+    for (; count < a_maxEvents; ++count)
+    {
+        std::optional<Event> event = a_queue.Pop();
+        if (!event)
+        {
+            break;
+        }
+        if (snapshot)
+        {
+            InvokeBatch(*snapshot, &*event, 1, BatchOrder::EventMajor);
+        }
+    }
+    CountDispatches(count);
+    return count;
+}
+
+//--------------------------------------------------------------
+//! Dispatches an event to all registered listeners on a worker
+//! thread of the default thread pool (see ThreadPool::Default).
+//!
+//! \param[in] a_args Arguments copied then passed to listeners.
+//! \return Completion that reports when the event was delivered.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+Completion BasicDispatcher<Policy, Args...>::DispatchAsync(const Args&... a_args)
+{
+    return DispatchAsync(ThreadPool::Default(), a_args...);
+}
+
+//--------------------------------------------------------------
+//! Hands an event to an executor, which dispatches it to all the
+//! registered listeners exactly as Dispatch would (in priority
+//! order, until a listener returns Status::Consumed), but using
+//! the snapshot of listeners current when the task is run.
+//!
+//! The arguments are copied once, into the same allocation as the
+//! completion state, and passed by reference to every listener.
+//! Events dispatched asynchronously may be delivered in any order
+//! (eg. by different worker threads), and the dispatcher must not
+//! be destroyed until all of them have completed.
+//!
+//! \param[in] a_executor Executor that delivers the event.
+//! \param[in] a_args Arguments copied then passed to listeners.
+//! \return Completion that reports when the event was delivered.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+Completion BasicDispatcher<Policy, Args...>::DispatchAsync(Executor& a_executor,
+                                                           const Args&... a_args)
+{
+    static_assert(Locking::Concurrent, "DispatchAsync requires a thread safe Locking policy");
+    std::shared_ptr<AsyncEvent> asyncEvent = std::make_shared<AsyncEvent>(this,
+                                                                          a_args...);
+    a_executor.Execute([asyncEvent]()
+    {
+        const uint64_t epoch = ExpiryEpoch().load(std::memory_order_acquire);
+        std::optional<typename Locking::ReadGuard> readGuard(std::in_place,
+                                                             asyncEvent->m_dispatcher->m_readers);
+        const Snapshot* snapshot = readGuard->Protect(asyncEvent->m_dispatcher->m_listeners);
+        const bool consumed = snapshot &&
+                              std::apply([snapshot, &epoch](const auto&... a_args)
+        {
+            return Invoke(*snapshot, epoch, a_args...);
+        }, asyncEvent->m_event);
+        readGuard.reset();
+        asyncEvent->m_dispatcher->CountDispatches(1);
+        asyncEvent->Complete(consumed);
+    });
+    return Completion(std::move(asyncEvent));
+}
+
+//--------------------------------------------------------------
+//! Dispatches an event to all registered listeners, running the
+//! listeners within each sort index band in parallel on worker
+//! threads of the default thread pool (see ThreadPool::Default).
+//!
+//! \param[in] a_args Arguments passed by reference to listeners.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::DispatchParallel(const Args&... a_args)
+{
+    DispatchParallel(ThreadPool::Default(), a_args...);
+}
+
+//--------------------------------------------------------------
+//! Dispatches an event to all registered listeners, in bands of
+//! listeners that share the same sort index (in priority order).
+//! Listeners within a band have no ordering dependency, so they
+//! are invoked concurrently by tasks handed to the executor, and
+//! by the calling thread, which then waits for the whole band to
+//! finish before starting the next. If any listener in a band
+//! returns Status::Consumed, the rest of that band still runs but
+//! no lower priority bands are invoked.
+//!
+//! Listeners sharing a band must be safe to invoke concurrently.
+//! The calling thread invokes any listeners that the executor has
+//! not started yet, so this never waits on queued tasks, and may
+//! be called from a task that is run by the same executor.
+//!
+//! \param[in] a_executor Executor that helps to invoke listeners.
+//! \param[in] a_args Arguments passed by reference to listeners.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::DispatchParallel(Executor& a_executor,
+                                                        const Args&... a_args)
+{
+    static_assert(Locking::Concurrent, "DispatchParallel requires a thread safe Locking policy");
+    const DispatchDepth depth;
+
+    // Grab the current snapshot without locking the mutex.
+    const uint64_t epoch = ExpiryEpoch().load(std::memory_order_acquire);
+    typename Locking::ReadGuard readGuard(m_readers);
+    const Snapshot* snapshot = readGuard.Protect(m_listeners);
+    CountDispatches(1);
+    if (!snapshot)
+    {
+        return;
+    }
+
+    const std::tuple<const Args&...> args(a_args...);
+    const std::pmr::vector<Entry*>& entries = snapshot->m_entries;
+    for (size_t first = 0, last = 0; first < entries.size(); first = last)
+    {
+        // Find the end of the band that shares this sort index.
+        const int32_t sortIndex = entries[first]->m_sortIndex;
+        for (last = first + 1; last < entries.size(); ++last)
+        {
+            if (entries[last]->m_sortIndex != sortIndex)
+            {
+                break;
+            }
+        }
+
+        // Bands with one listener are invoked directly.
+        const size_t count = last - first;
+        if (count == 1)
+        {
+            const Entry* entry = entries[first];
+            if (!entry->Expired(epoch) && entry->m_callable &&
+                Call(*entry, a_args...) == Status::Consumed)
+            {
+                // Stop sending the event.
+                break;
+            }
+            continue;
+        }
+
+        // Bands are shared with tasks that may only start after
+        // this returns, which then find no listeners left to run.
+        std::shared_ptr<ParallelBand> band = std::make_shared<ParallelBand>(&entries[first],
+                                                                            count,
+                                                                            epoch,
+                                                                            &args);
+        const size_t taskCount = std::min(count - 1, a_executor.Concurrency());
+        for (size_t i = 0; i < taskCount; ++i)
+        {
+            a_executor.Execute([band]()
+            {
+                band->Run();
+            });
+        }
+        band->Run();
+        band->Wait();
+        if (band->m_consumed.load(std::memory_order_acquire))
+        {
+            // Stop sending the event.
+            break;
+        }
+    }
+}
+
+//--------------------------------------------------------------
+//! Statistics recorded by the dispatcher, which is only available
+//! when it is instantiated with an InstrumentedPolicy.
+//!
+//! \return Statistics for the dispatcher since it was created.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+DispatcherStatistics BasicDispatcher<Policy, Args...>::Statistics() const
+{
+    static_assert(Instrumented, "Statistics require an InstrumentedPolicy");
+    DispatcherStatistics statistics;
+    statistics.m_dispatches = m_counters.m_dispatches.Load();
+    statistics.m_prunedListeners = m_counters.m_prunedListeners.load(std::memory_order_relaxed);
+    statistics.m_lockWaitTime = std::chrono::nanoseconds(m_counters.m_lockWaitTime.Load());
+    return statistics;
+}
+
+//--------------------------------------------------------------
+//! Statistics recorded for each registered listener, which is only
+//! available when instantiated with an InstrumentedPolicy. Each
+//! Listener or Connection can also be queried for its statistics.
+//!
+//! \return Statistics for each listener, in priority order.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+std::vector<ListenerStatistics> BasicDispatcher<Policy, Args...>::CollectListenerStatistics() const
+{
+    static_assert(Instrumented, "Statistics require an InstrumentedPolicy");
+    const uint64_t epoch = ExpiryEpoch().load(std::memory_order_acquire);
+    typename Locking::ReadGuard readGuard(m_readers);
+    const Snapshot* snapshot = readGuard.Protect(m_listeners);
+    std::vector<ListenerStatistics> statistics;
+    if (snapshot)
+    {
+        statistics.reserve(snapshot->m_entries.size());
+        for (const Entry* entry : snapshot->m_entries)
+        {
+            if (!entry->Expired(epoch))
+            {
+                statistics.push_back(entry->Load(entry->m_sortIndex));
+            }
+        }
+    }
+    return statistics;
+}
+
+//--------------------------------------------------------------
+//! Invokes the callable of a listener, timing it and recording
+//! the status it returns if the dispatcher is instrumented.
+//!
+//! \param[in] a_entry Entry that owns the callable to invoke.
+//! \param[in] a_args Arguments passed by reference to listeners.
+//! \return Status returned by the callable.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+Status BasicDispatcher<Policy, Args...>::Call(const Entry& a_entry,
+                                              const Args&... a_args)
+{
+    if constexpr (Instrumented)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const Status status = a_entry.m_callable(a_args...);
+        a_entry.Record(status, std::chrono::steady_clock::now() - start);
+        return status;
+    }
+    else
+    {
+        return a_entry.m_callable(a_args...);
+    }
+}
+
+//--------------------------------------------------------------
+//! Sends an event to each listener in a snapshot that had not
+//! expired before the event was dispatched, in priority order.
+//!
+//! \param[in] a_snapshot Snapshot of the listeners to invoke.
+//! \param[in] a_epoch Expiry epoch when the event was dispatched.
+//! \param[in] a_args Arguments passed by reference to listeners.
+//! \return True if a listener consumed the event.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+bool BasicDispatcher<Policy, Args...>::Invoke(const Snapshot& a_snapshot,
+                                              const uint64_t& a_epoch,
+                                              const Args&... a_args)
+{
+    for (const Entry* entry : a_snapshot.m_entries)
+    {
+        if (entry->Expired(a_epoch))
+        {
+            continue;
+        }
+
+        // Invoke in place, the snapshot keeps the entry alive even
+        // if the listener is released while it is being invoked.
+        const Callable& callable = entry->m_callable;
+        if (callable)
+        {
+            Status status = Call(*entry, a_args...);
+            if (status == Status::Consumed)
+            {
+                // Stop sending the event.
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+//--------------------------------------------------------------
+//! Sends a batch of events to each listener in a snapshot, in the
+//! requested order. Listener major batches are split into chunks
+//! of 64 events, tracking which have been consumed with a bitmask,
+//! so no memory is allocated however large the batch is.
+//!
+//! \param[in] a_snapshot Snapshot of the listeners to invoke.
+//! \param[in] a_events Pointer to the first event in the batch.
+//! \param[in] a_count Number of events in the batch.
+//! \param[in] a_order Order in which to deliver the events.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::InvokeBatch(const Snapshot& a_snapshot,
+                                                   const Event* a_events,
+                                                   size_t a_count,
+                                                   BatchOrder a_order)
+{
+    if (a_order == BatchOrder::EventMajor)
+    {
+        for (size_t i = 0; i < a_count; ++i)
+        {
+            const uint64_t epoch = ExpiryEpoch().load(std::memory_order_acquire);
+            std::apply([&a_snapshot, &epoch](const auto&... a_args)
+            {
+                Invoke(a_snapshot, epoch, a_args...);
+            }, a_events[i]);
+        }
+        return;
+    }
+
+    for (size_t first = 0; first < a_count; first += 64)
+    {
+        // Each set bit is an event in the chunk not yet consumed.
+        const size_t chunkSize = std::min<size_t>(64, a_count - first);
+        uint64_t pending = (chunkSize == 64) ? ~uint64_t(0) :
+                                               (uint64_t(1) << chunkSize) - 1;
+        const uint64_t epoch = ExpiryEpoch().load(std::memory_order_acquire);
+        for (const Entry* entry : a_snapshot.m_entries)
+        {
+            const Callable& callable = entry->m_callable;
+            if (!pending)
+            {
+                // Every event in the chunk was consumed.
+                break;
+            }
+            if (entry->Expired(epoch) || !callable)
+            {
+                continue;
+            }
+
+            for (size_t i = 0; i < chunkSize; ++i)
+            {
+                const uint64_t bit = uint64_t(1) << i;
+                if (!(pending & bit))
+                {
+                    continue;
+                }
+                const Status status = std::apply([entry](const auto&... a_args)
+                {
+                    return Call(*entry, a_args...);
+                }, a_events[first + i]);
+                if (status == Status::Consumed)
+                {
+                    // Stop sending the event.
+                    pending &= ~bit;
+                }
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------
+//! Reallocates the ring buffer that stores queued events, moving
+//! the queued events to the start of the new buffer (in order).
+//! Only call while holding the queue mutex.
+//!
+//! \param[in] a_capacity Number of events that can be queued.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::Grow(size_t a_capacity)
+{
+    std::pmr::vector<std::optional<Event>> queue(a_capacity, m_resource);
+    for (size_t i = 0; i < m_queueSize; ++i)
+    {
+        queue[i] = std::move(m_queue[(m_queueFront + i) % m_queue.size()]);
+    }
+    m_queue.swap(queue);
+    m_queueFront = 0;
+}
+
+//--------------------------------------------------------------
+//! Rebuilds the immutable snapshot of listeners that is read by
+//! each dispatch, pruning expired listeners, then publishes it.
+//! Only call while holding the listeners mutex (single writer).
+//!
+//! Listeners are stored in a contiguous array sorted by their
+//! sort index, with listeners that share a sort index kept in
+//! the order that they were registered, so a dispatch is just a
+//! linear walk; the array is compacted each time it is rebuilt.
+//!
+//! \param[in] a_entries Optional entries to insert into the snapshot,
+//!            which all share one sort index, in registration order.
+//! \param[in] a_count Number of entries to insert.
+//! \return Number of expired listeners that were pruned.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+size_t BasicDispatcher<Policy, Args...>::Publish(Entry* const* a_entries,
+                                                 size_t a_count)
+{
+    static const Snapshot s_empty(std::pmr::new_delete_resource());
+    const Snapshot* previous = m_listeners.load(std::memory_order_relaxed);
+    const std::pmr::vector<Entry*>& listeners = previous ? previous->m_entries :
+                                                           s_empty.m_entries;
+    Snapshot* snapshot = Snapshot::Create(m_resource);
+    std::pmr::vector<Entry*>& entries = snapshot->m_entries;
+    entries.reserve(listeners.size() + a_count);
+
+    // Copy non-expired listeners, inserting the new entries after
+    // all existing entries that have the same (or lower) index.
+    bool inserted = a_count == 0;
+    for (Entry* entry : listeners)
+    {
+        if (!inserted && a_entries[0]->m_sortIndex < entry->m_sortIndex)
+        {
+            entries.insert(entries.end(), a_entries, a_entries + a_count);
+            inserted = true;
+        }
+        if (!entry->m_expiredEpoch.load(std::memory_order_acquire))
+        {
+            entries.push_back(entry);
+        }
+    }
+    if (!inserted)
+    {
+        entries.insert(entries.end(), a_entries, a_entries + a_count);
+    }
+    for (Entry* entry : entries)
+    {
+        entry->Retain();
+    }
+    m_expiredCount = 0;
+    const size_t pruned = listeners.size() + a_count - entries.size();
+    if constexpr (Instrumented)
+    {
+        m_counters.m_prunedListeners.fetch_add(pruned, std::memory_order_relaxed);
+    }
+
+    // Dispatches in progress keep using the previous snapshot,
+    // which is retired then deleted once no longer protected.
+    m_listeners.store(snapshot, Locking::PublishOrder);
+    if (previous)
+    {
+        m_retired.push_back(const_cast<Snapshot*>(previous));
+    }
+    Locking::Reclaim(m_readers, m_retired, Snapshot::Destroy);
+    return pruned;
+}
+
+//--------------------------------------------------------------
+//! Counts listeners that were expired (by removing them), then
+//! compacts the listeners if most of them have expired, so the
+//! amortized cost of removal does not depend on their number.
+//!
+//! \param[in] a_count Number of listeners that were expired.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::CountExpired(size_t a_count)
+{
+    // Compact the container if most of the entries have expired.
+    std::unique_lock<Mutex> lock = Lock(m_listenersMutex);
+    m_expiredCount += a_count;
+    const Snapshot* snapshot = m_listeners.load(std::memory_order_relaxed);
+    if (m_autoCompact && snapshot && m_expiredCount * 2 > snapshot->m_entries.size())
+    {
+        Publish();
+    }
+}
+
+//--------------------------------------------------------------
+//! Locks a mutex of the dispatcher, recording the time spent
+//! waiting for it if the dispatcher is instrumented.
+//!
+//! \param[in] a_mutex Mutex to lock.
+//! \return Lock that owns the mutex.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+std::unique_lock<typename BasicDispatcher<Policy, Args...>::Mutex>
+BasicDispatcher<Policy, Args...>::Lock(Mutex& a_mutex)
+{
+    if constexpr (Instrumented)
+    {
+        std::unique_lock<Mutex> lock(a_mutex, std::try_to_lock);
+        if (!lock.owns_lock())
+        {
+            const auto start = std::chrono::steady_clock::now();
+            lock.lock();
+            const auto waited = std::chrono::steady_clock::now() - start;
+            m_counters.m_lockWaitTime.Add(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count()));
+        }
+        return lock;
+    }
+    else
+    {
+        return std::unique_lock<Mutex>(a_mutex);
+    }
+}
+
+//--------------------------------------------------------------
+//! Adds to the number of events dispatched, if instrumented.
+//!
+//! \param[in] a_count Number of events that were dispatched.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::CountDispatches(size_t a_count)
+{
+    if constexpr (Instrumented)
+    {
+        m_counters.m_dispatches.Add(a_count);
+    }
+    else
+    {
+        (void)a_count;
+    }
+}
+
+//--------------------------------------------------------------
+//! Global clock that is advanced each time a listener expires,
+//! so a dispatch can ignore entries expired before it started.
+//!
+//! \return Reference to the expiry epoch shared by dispatchers.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+std::atomic<uint64_t>& BasicDispatcher<Policy, Args...>::ExpiryEpoch()
+{
+    static std::atomic<uint64_t> s_epoch = { 0 };
+    return s_epoch;
+}
+
+//--------------------------------------------------------------
+//! Global count of entries added to dispatchers, which numbers
+//! each entry, so entries of several dispatchers that share a sort
+//! index can be merged in the order they were registered.
+//!
+//! \return Reference to the registration sequence shared by dispatchers.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+std::atomic<uint64_t>& BasicDispatcher<Policy, Args...>::RegistrationSequence()
+{
+    static std::atomic<uint64_t> s_sequence = { 0 };
+    return s_sequence;
+}
+
+//--------------------------------------------------------------
+//! AsyncEvent objects hold a copy of an event that is dispatched
+//! asynchronously, along with the state of its completion.
+//!
+//! \param[in] a_dispatcher Dispatcher that delivers the event.
+//! \param[in] a_args Arguments copied then passed to listeners.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::AsyncEvent::AsyncEvent(BasicDispatcher* a_dispatcher,
+                                                         const Args&... a_args)
+    : m_dispatcher(a_dispatcher)
+    , m_event(a_args...)
+{
+}
+
+//--------------------------------------------------------------
+//! ParallelBand objects share a band of listeners (that all have
+//! the same sort index) between the threads that invoke them.
+//!
+//! \param[in] a_entries Pointer to the first entry in the band.
+//! \param[in] a_count Number of entries in the band.
+//! \param[in] a_epoch Expiry epoch when the event was dispatched.
+//! \param[in] a_args Arguments passed by reference to listeners.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::ParallelBand::ParallelBand(Entry* const* a_entries,
+                                                             size_t a_count,
+                                                             const uint64_t& a_epoch,
+                                                             const std::tuple<const Args&...>* a_args)
+    : m_entries(a_entries)
+    , m_count(a_count)
+    , m_epoch(a_epoch)
+    , m_args(a_args)
+{
+}
+
+//--------------------------------------------------------------
+//! Claims and invokes listeners of the band until none are left.
+//! Entries and arguments are only accessed after claiming one, so
+//! the dispatch is guaranteed to be waiting for it to finish.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::ParallelBand::Run()
+{
+    while (true)
+    {
+        const size_t index = m_next.fetch_add(1, std::memory_order_relaxed);
+        if (index >= m_count)
+        {
+            return;
+        }
+
+        const Entry* entry = m_entries[index];
+        const Callable& callable = entry->m_callable;
+        if (!entry->Expired(m_epoch) && callable)
+        {
+            const Status status = std::apply([entry](const auto&... a_args)
+            {
+                return Call(*entry, a_args...);
+            }, *m_args);
+            if (status == Status::Consumed)
+            {
+                m_consumed.store(true, std::memory_order_release);
+            }
+        }
+        if (m_done.fetch_add(1, std::memory_order_acq_rel) + 1 == m_count)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_completed.notify_all();
+        }
+    }
+}
+
+//--------------------------------------------------------------
+//! Blocks the calling thread until every listener in the band
+//! has been invoked (or skipped, if it had already expired).
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::ParallelBand::Wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_completed.wait(lock, [this]()
+    {
+        return m_done.load(std::memory_order_acquire) == m_count;
+    });
+}
+
+//--------------------------------------------------------------
+//! Records one invocation of a listener. Counters are only ever
+//! updated with relaxed atomics, and are cache line aligned, so
+//! listeners never share the cache lines that they update.
+//!
+//! \param[in] a_status Status returned by the listener.
+//! \param[in] a_time Time spent invoking the listener.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::ListenerCounters::Record(Status a_status,
+                                                                std::chrono::nanoseconds a_time) const
+{
+    const int64_t time = a_time.count();
+    m_invocations.fetch_add(1, std::memory_order_relaxed);
+    m_statuses[static_cast<size_t>(a_status) % 3].fetch_add(1, std::memory_order_relaxed);
+    m_totalTime.fetch_add(time, std::memory_order_relaxed);
+    int64_t maxTime = m_maxTime.load(std::memory_order_relaxed);
+    while (time > maxTime &&
+           !m_maxTime.compare_exchange_weak(maxTime, time, std::memory_order_relaxed))
+    {
+    }
+}
+
+//--------------------------------------------------------------
+//! Reads the counters recorded for a listener.
+//!
+//! \param[in] a_sortIndex Sort index the listener was registered with.
+//! \return Statistics for the listener.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+ListenerStatistics BasicDispatcher<Policy, Args...>::ListenerCounters::Load(const int32_t& a_sortIndex) const
+{
+    ListenerStatistics statistics;
+    statistics.m_sortIndex = a_sortIndex;
+    statistics.m_invocations = m_invocations.load(std::memory_order_relaxed);
+    statistics.m_continued = m_statuses[static_cast<size_t>(Status::Continue)].load(std::memory_order_relaxed);
+    statistics.m_consumed = m_statuses[static_cast<size_t>(Status::Consumed)].load(std::memory_order_relaxed);
+    statistics.m_filtered = m_statuses[static_cast<size_t>(Status::Filtered)].load(std::memory_order_relaxed);
+    statistics.m_totalTime = std::chrono::nanoseconds(m_totalTime.load(std::memory_order_relaxed));
+    statistics.m_maxTime = std::chrono::nanoseconds(m_maxTime.load(std::memory_order_relaxed));
+    return statistics;
+}
+
+//--------------------------------------------------------------
+//! Entry objects own a registered callable on behalf of every
+//! snapshot and connection that holds a reference to the entry,
+//! and record when it was deregistered. Entries start with one
+//! reference, which is adopted by the connection that owns it.
+//!
+//! \param[in] a_resource Memory resource the entry was allocated from.
+//! \param[in] a_callable A callable object that will be invoked.
+//! \param[in] a_sortIndex Order in which to invoke the callable.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::Entry::Entry(std::pmr::memory_resource* a_resource,
+                                               Callable&& a_callable,
+                                               const int32_t& a_sortIndex)
+    : m_resource(a_resource)
+    , m_callable(std::move(a_callable))
+    , m_expiredEpoch(0)
+    , m_references(1)
+    , m_sortIndex(a_sortIndex)
+{
+}
+
+//--------------------------------------------------------------
+//! Allocates an entry from a memory resource, which is returned to
+//! the same resource when its last reference is released.
+//!
+//! \param[in] a_resource Memory resource to allocate the entry from.
+//! \param[in] a_callable A callable object that will be invoked.
+//! \param[in] a_sortIndex Order in which to invoke the callable.
+//! \return Entry that was created, with one reference.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+typename BasicDispatcher<Policy, Args...>::Entry*
+BasicDispatcher<Policy, Args...>::Entry::Create(std::pmr::memory_resource* a_resource,
+                                                Callable&& a_callable,
+                                                const int32_t& a_sortIndex)
+{
+    void* memory = a_resource->allocate(sizeof(Entry), alignof(Entry));
+    return new (memory) Entry(a_resource, std::move(a_callable), a_sortIndex);
+}
+
+//--------------------------------------------------------------
+//! Checks whether the entry expired before a dispatch started.
+//!
+//! \param[in] a_epoch Expiry epoch at the start of the dispatch.
+//! \return True if the entry should not be invoked by dispatch.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+bool BasicDispatcher<Policy, Args...>::Entry::Expired(const uint64_t& a_epoch) const
+{
+    const uint64_t expired = m_expiredEpoch.load(std::memory_order_acquire);
+    return expired != 0 && expired <= a_epoch;
+}
+
+//--------------------------------------------------------------
+//! Marks the entry as expired, using the next expiry epoch value.
+//!
+//! \return True if expired by this call or false if previously.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+bool BasicDispatcher<Policy, Args...>::Entry::Expire()
+{
+    return Expire(++ExpiryEpoch());
+}
+
+//--------------------------------------------------------------
+//! Marks the entry as expired, using an expiry epoch value that
+//! was already taken (eg. to expire many entries at once).
+//!
+//! \param[in] a_epoch Expiry epoch value to mark the entry with.
+//! \return True if expired by this call or false if previously.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+bool BasicDispatcher<Policy, Args...>::Entry::Expire(const uint64_t& a_epoch)
+{
+    uint64_t expected = 0;
+    return m_expiredEpoch.compare_exchange_strong(expected, a_epoch);
+}
+
+//--------------------------------------------------------------
+//! Adds a reference to the entry.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::Entry::Retain()
+{
+    m_references.fetch_add(1, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+//! Removes a reference to the entry, deleting it if the last.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::Entry::Release()
+{
+    if (m_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        std::pmr::memory_resource* resource = m_resource;
+        this->~Entry();
+        resource->deallocate(this, sizeof(Entry), alignof(Entry));
+    }
+}
+
+//--------------------------------------------------------------
+//! Snapshot objects hold an array of listeners, allocated from the
+//! same memory resource as the snapshot itself.
+//!
+//! \param[in] a_resource Memory resource the snapshot was allocated from.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::Snapshot::Snapshot(std::pmr::memory_resource* a_resource)
+    : m_entries(a_resource)
+{
+}
+
+//--------------------------------------------------------------
+//! Releases the reference that the snapshot holds to each entry.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::Snapshot::~Snapshot()
+{
+    for (Entry* entry : m_entries)
+    {
+        entry->Release();
+    }
+}
+
+//--------------------------------------------------------------
+//! Allocates an empty snapshot from a memory resource.
+//!
+//! \param[in] a_resource Memory resource to allocate the snapshot from.
+//! \return Snapshot that was created.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+typename BasicDispatcher<Policy, Args...>::Snapshot*
+BasicDispatcher<Policy, Args...>::Snapshot::Create(std::pmr::memory_resource* a_resource)
+{
+    void* memory = a_resource->allocate(sizeof(Snapshot), alignof(Snapshot));
+    return new (memory) Snapshot(a_resource);
+}
+
+//--------------------------------------------------------------
+//! Destroys a snapshot, returning it to the memory resource that
+//! it was allocated from (which its array of listeners also uses).
+//!
+//! \param[in] a_snapshot Snapshot to destroy.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::Snapshot::Destroy(Snapshot* a_snapshot)
+{
+    std::pmr::memory_resource* resource = a_snapshot->m_entries.get_allocator().resource();
+    a_snapshot->~Snapshot();
+    resource->deallocate(a_snapshot, sizeof(Snapshot), alignof(Snapshot));
+}
+
+//--------------------------------------------------------------
+//! Connection objects are created by the dispatcher for each
+//! registered callable, adopting the entry's first reference.
+//!
+//! \param[in] a_entry Entry that owns the registered callable.
+//! \param[in] a_dispatcher Dispatcher the entry is stored in.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::Connection::Connection(Entry* a_entry,
+                                                         const BasicDispatcher* a_dispatcher)
+    : m_entry(a_entry)
+    , m_dispatcher(a_dispatcher)
+{
+}
+
+//--------------------------------------------------------------
+//! Moves a connection, leaving the other connection empty.
+//!
+//! \param[in] a_other Connection to move into this connection.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::Connection::Connection(Connection&& a_other) noexcept
+    : m_entry(a_other.m_entry)
+    , m_dispatcher(a_other.m_dispatcher)
+{
+    a_other.m_entry = nullptr;
+    a_other.m_dispatcher = nullptr;
+}
+
+//--------------------------------------------------------------
+//! Disconnects this, then moves the other connection into this.
+//!
+//! \param[in] a_other Connection to move into this connection.
+//! \return Reference to this connection.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+typename BasicDispatcher<Policy, Args...>::Connection&
+BasicDispatcher<Policy, Args...>::Connection::operator=(Connection&& a_other) noexcept
+{
+    if (this != &a_other)
+    {
+        Disconnect();
+        m_entry = a_other.m_entry;
+        m_dispatcher = a_other.m_dispatcher;
+        a_other.m_entry = nullptr;
+        a_other.m_dispatcher = nullptr;
+    }
+    return *this;
+}
+
+//--------------------------------------------------------------
+//! Disconnects the callable so it will not be invoked again.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::Connection::~Connection()
+{
+    Disconnect();
+}
+
+//--------------------------------------------------------------
+//! Checks whether the connection holds a registered callable.
+//!
+//! \return True if connected, or false if empty or disconnected.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::Connection::operator bool() const noexcept
+{
+    return m_entry != nullptr;
+}
+
+//--------------------------------------------------------------
+//! Function call operator which invokes the registered callable
+//! directly, bypassing the dispatcher (and any other listeners).
+//!
+//! \param[in] a_args Arguments passed to the registered callable.
+//! \return Status returned by the callable, or Status::Filtered
+//!         if disconnected or the callable is empty.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+Status BasicDispatcher<Policy, Args...>::Connection::operator()(const Args&... a_args) const
+{
+    return (m_entry && m_entry->m_callable) ? m_entry->m_callable(a_args...) :
+                                              Status::Filtered;
+}
+
+//--------------------------------------------------------------
+//! Expires the entry, so the callable will not be invoked by any
+//! subsequent dispatch, and releases the connection's reference.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::Connection::Disconnect()
+{
+    if (m_entry)
+    {
+        m_entry->Expire();
+        m_entry->Release();
+        m_entry = nullptr;
+        m_dispatcher = nullptr;
+    }
+}
+
+//--------------------------------------------------------------
+//! Statistics recorded for the registered callable when invoked by
+//! an instrumented dispatcher (calls made directly through the
+//! connection are not recorded).
+//!
+//! \return Statistics for the listener, or empty if disconnected.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+ListenerStatistics BasicDispatcher<Policy, Args...>::Connection::Statistics() const
+{
+    static_assert(Instrumented, "Statistics require an InstrumentedPolicy");
+    return m_entry ? m_entry->Load(m_entry->m_sortIndex) : ListenerStatistics();
+}
+
+//--------------------------------------------------------------
+//! Registration objects are created by the dispatcher for each
+//! registered callable and handed to the caller as a Listener.
+//!
+//! \param[in] a_connection Connection to the registered callable.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::Registration::Registration(Connection&& a_connection)
+    : m_connection(std::move(a_connection))
+{
+}
+
+//--------------------------------------------------------------
+//! Function call operator which invokes the registered callable
+//! directly, bypassing the dispatcher (and any other listeners).
+//!
+//! \param[in] a_args Arguments passed to the registered callable.
+//! \return Status returned by the callable, or Status::Filtered
+//!         if the callable is empty.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+Status BasicDispatcher<Policy, Args...>::Registration::operator()(const Args&... a_args) const
+{
+    return m_connection(a_args...);
+}
+
+//--------------------------------------------------------------
+//! Statistics recorded for the registered callable when invoked by
+//! an instrumented dispatcher.
+//!
+//! \return Statistics for the listener.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+ListenerStatistics BasicDispatcher<Policy, Args...>::Registration::Statistics() const
+{
+    return m_connection.Statistics();
+}
+
+//--------------------------------------------------------------
+//! Creates an empty group for a dispatcher, which connections made
+//! with the dispatcher can be added to.
+//!
+//! \param[in] a_dispatcher Dispatcher that the listeners belong to.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::ListenerGroup::ListenerGroup(BasicDispatcher& a_dispatcher)
+    : m_entries(a_dispatcher.m_resource)
+    , m_dispatcher(&a_dispatcher)
+{
+}
+
+//--------------------------------------------------------------
+//! Moves the listeners of another group into this one.
+//!
+//! \param[in] a_other Group to move the listeners from.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::ListenerGroup::ListenerGroup(ListenerGroup&& a_other) noexcept
+    : m_entries(std::move(a_other.m_entries))
+    , m_dispatcher(a_other.m_dispatcher)
+{
+    a_other.m_entries.clear();
+    a_other.m_dispatcher = nullptr;
+}
+
+//--------------------------------------------------------------
+//! Deregisters the listeners of this group, then moves those of
+//! another group into this one.
+//!
+//! \param[in] a_other Group to move the listeners from.
+//! \return Reference to this group.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+typename BasicDispatcher<Policy, Args...>::ListenerGroup&
+BasicDispatcher<Policy, Args...>::ListenerGroup::operator=(ListenerGroup&& a_other) noexcept
+{
+    if (this != &a_other)
+    {
+        Clear();
+        m_entries = std::move(a_other.m_entries);
+        m_dispatcher = a_other.m_dispatcher;
+        a_other.m_entries.clear();
+        a_other.m_dispatcher = nullptr;
+    }
+    return *this;
+}
+
+//--------------------------------------------------------------
+//! Deregisters all listeners of the group.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::ListenerGroup::~ListenerGroup()
+{
+    Clear();
+}
+
+//--------------------------------------------------------------
+//! Adds a connection to the group, which then owns its listener.
+//!
+//! \param[in] a_connection Connection made with the same dispatcher.
+//! \return True if the connection was added or false otherwise.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+bool BasicDispatcher<Policy, Args...>::ListenerGroup::Add(Connection&& a_connection)
+{
+    if (!a_connection || a_connection.m_dispatcher != m_dispatcher)
+    {
+        return false;
+    }
+    m_entries.push_back(a_connection.m_entry);
+    a_connection.m_entry = nullptr;
+    a_connection.m_dispatcher = nullptr;
+    return true;
+}
+
+//--------------------------------------------------------------
+//! Deregisters all listeners of the group in a single pass, all
+//! expired with the same epoch, then counted by the dispatcher in
+//! one go (which compacts its listeners if most have expired).
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicDispatcher<Policy, Args...>::ListenerGroup::Clear()
+{
+    if (m_entries.empty())
+    {
+        return;
+    }
+    const uint64_t epoch = ++ExpiryEpoch();
+    size_t expired = 0;
+    for (Entry* entry : m_entries)
+    {
+        expired += entry->Expire(epoch) ? 1 : 0;
+    }
+    m_dispatcher->CountExpired(expired);
+    for (Entry* entry : m_entries)
+    {
+        entry->Release();
+    }
+    m_entries.clear();
+}
+
+//--------------------------------------------------------------
+//! Number of listeners in the group.
+//!
+//! \return Number of listeners.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+size_t BasicDispatcher<Policy, Args...>::ListenerGroup::Size() const
+{
+    return m_entries.size();
+}
+
+//--------------------------------------------------------------
+//! Creates a cursor positioned before the first listener.
+//!
+//! \param[in] a_endSequence Sequence of the first listener that
+//!            was registered after the dispatch began.
+//! \param[in] a_args Arguments copied then passed to listeners.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::Cursor::Cursor(uint64_t a_endSequence,
+                                                 const Args&... a_args)
+    : m_event(a_args...)
+    , m_endSequence(a_endSequence)
+{
+}
+
+//--------------------------------------------------------------
+//! Whether the event has been delivered to every listener (or was
+//! consumed), so the dispatch does not need to be resumed.
+//!
+//! \return True if the dispatch is done.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+bool BasicDispatcher<Policy, Args...>::Cursor::Done() const
+{
+    return m_done;
+}
+
+//--------------------------------------------------------------
+//! Whether a listener returned Status::Consumed for the event.
+//!
+//! \return True if the event was consumed.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+bool BasicDispatcher<Policy, Args...>::Cursor::Consumed() const
+{
+    return m_consumed;
+}
+
+//--------------------------------------------------------------
+//! Filter objects are essentially event listeners that are only
+//! invoked if a filter function with the same args returns true.
+//!
+//! \param[in] a_function Function to filter all incoming events.
+//! \param[in] a_callable Callable to be invoked unless filtered.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicDispatcher<Policy, Args...>::Filter::Filter(Function a_function,
+                                                 Callable a_callable)
+    : m_function(std::move(a_function))
+    , m_callable(std::move(a_callable))
+{
+}
+
+//--------------------------------------------------------------
+//! Function call operator which allows the filter object to be
+//! registered directly with an event dispatcher as a callable.
+//!
+//! \param[in] a_args Arguments passed to filter and callable.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+Status BasicDispatcher<Policy, Args...>::Filter::operator()(const Args&... a_args) const
+{
+    return (m_callable && m_function && m_function(a_args...)) ?
+            m_callable(a_args...) : Status::Filtered;
+}
+
+//--------------------------------------------------------------
+//! Completion objects are created by the dispatcher for events
+//! that are dispatched asynchronously.
+//!
+//! \param[in] a_state State shared with the executor's task.
+//--------------------------------------------------------------
+inline Completion::Completion(std::shared_ptr<State> a_state)
+    : m_state(std::move(a_state))
+{
+}
+
+//--------------------------------------------------------------
+//! Checks whether the completion refers to a dispatched event.
+//!
+//! \return True if not empty, or false if default constructed.
+//--------------------------------------------------------------
+inline Completion::operator bool() const noexcept
+{
+    return m_state != nullptr;
+}
+
+//--------------------------------------------------------------
+//! Checks whether the event has been delivered, without waiting.
+//!
+//! \return True if all listeners invoked have returned.
+//--------------------------------------------------------------
+inline bool Completion::Ready() const
+{
+    return !m_state || m_state->m_ready.load(std::memory_order_acquire);
+}
+
+//--------------------------------------------------------------
+//! Blocks the calling thread until the event has been delivered.
+//--------------------------------------------------------------
+inline void Completion::Wait() const
+{
+    if (Ready())
+    {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_state->m_mutex);
+    m_state->m_completed.wait(lock, [this]()
+    {
+        return m_state->m_ready.load(std::memory_order_acquire);
+    });
+}
+
+//--------------------------------------------------------------
+//! Waits until the event has been delivered, then checks whether
+//! a listener consumed it (by returning Status::Consumed).
+//!
+//! \return True if a listener consumed the event.
+//--------------------------------------------------------------
+inline bool Completion::Consumed() const
+{
+    Wait();
+    return m_state && m_state->m_consumed;
+}
+
+//--------------------------------------------------------------
+//! Records the result of the dispatch, then wakes any waiters.
+//!
+//! \param[in] a_consumed Whether a listener consumed the event.
+//--------------------------------------------------------------
+inline void Completion::State::Complete(bool a_consumed)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_consumed = a_consumed;
+        m_ready.store(true, std::memory_order_release);
+    }
+    m_completed.notify_all();
 }
 
 } // namespace Event
@@ -0,0 +1,314 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <simple/event/dispatcher.h>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Event
+{
+
+//--------------------------------------------------------------
+//! Template class that holds a dispatcher for each type of event
+//! (eg. one for MouseMoved, another for KeyPressed), so that many
+//! event types can be registered with and dispatched through one
+//! object, rather than wiring up a dispatcher for each by hand.
+//!
+//! Each event type is given an index the first time it is used (by
+//! any bus with the same policy), with no RTTI, and each bus finds
+//! the dispatcher for a type by indexing a table of atomic pointers,
+//! so dispatching does not lock a mutex or search a map. Dispatchers
+//! are created when a listener is first registered for their type,
+//! and are kept for the lifetime of the bus.
+//!
+//! Type indices are shared by every bus in a program, but not across
+//! shared libraries that do not share the same inline functions.
+//!
+//! \tparam Policy Class that defines how callables are stored.
+//--------------------------------------------------------------
+template<class Policy = DefaultPolicy>
+class BasicEventBus
+{
+public:
+    template<class Event>
+    using Dispatcher = BasicDispatcher<Policy, Event>;
+    template<class Event>
+    using Callable = typename Dispatcher<Event>::Callable;
+    template<class Event>
+    using Connection = typename Dispatcher<Event>::Connection;
+    template<class Event>
+    using Listener = typename Dispatcher<Event>::Listener;
+
+    BasicEventBus() = default;
+    ~BasicEventBus();
+
+    BasicEventBus(const BasicEventBus&) = delete;
+    BasicEventBus& operator=(const BasicEventBus&) = delete;
+
+    template<class Event>
+    [[nodiscard]]
+    Listener<Event> Register(Callable<Event> a_callable,
+                             const int32_t& a_sortIndex = 0);
+    template<class Event>
+    [[nodiscard]]
+    Connection<Event> Connect(Callable<Event> a_callable,
+                              const int32_t& a_sortIndex = 0);
+    template<class Event>
+    bool Remove(const Listener<Event>& a_listener);
+    template<class Event>
+    bool Remove(const Connection<Event>& a_connection);
+
+    template<class Event>
+    void Dispatch(const Event& a_event);
+    template<class Event>
+    Dispatcher<Event>& Get();
+    template<class Event>
+    Dispatcher<Event>* Find() const;
+
+    template<class Event>
+    static size_t TypeIndex();
+
+private:
+    static constexpr size_t ChunkSize = 64;
+    static constexpr size_t ChunkCount = 1024;
+
+    struct Holder
+    {
+        virtual ~Holder() = default;
+    };
+
+    template<class Event>
+    struct TypedHolder : Holder
+    {
+        Dispatcher<Event> m_dispatcher;
+    };
+
+    struct Chunk
+    {
+        std::atomic<Holder*> m_holders[ChunkSize] = {};
+    };
+
+    static std::atomic<size_t>& NextTypeIndex();
+
+    std::atomic<Chunk*> m_chunks[ChunkCount] = {};
+    std::mutex m_chunksMutex;
+};
+
+//--------------------------------------------------------------
+//! Event bus that stores callables using the default policy.
+//--------------------------------------------------------------
+using EventBus = BasicEventBus<DefaultPolicy>;
+
+//--------------------------------------------------------------
+//! Destroys the dispatchers, which must not be dispatching events.
+//--------------------------------------------------------------
+template<class Policy> inline
+BasicEventBus<Policy>::~BasicEventBus()
+{
+    for (std::atomic<Chunk*>& chunk : m_chunks)
+    {
+        if (Chunk* holders = chunk.load(std::memory_order_relaxed))
+        {
+            for (std::atomic<Holder*>& holder : holders->m_holders)
+            {
+                delete holder.load(std::memory_order_relaxed);
+            }
+            delete holders;
+        }
+    }
+}
+
+//--------------------------------------------------------------
+//! Registers a callable to invoke when events of a type are
+//! dispatched.
+//!
+//! \tparam Event Type of the events to invoke the callable for.
+//! \param[in] a_callable A callable object that will be invoked.
+//! \param[in] a_sortIndex Order in which to invoke the callable.
+//! \return Listener to retain while callable should be invoked.
+//!         Release all references to 'deregister' the callable.
+//--------------------------------------------------------------
+template<class Policy>
+template<class Event> inline
+typename BasicEventBus<Policy>::template Listener<Event>
+BasicEventBus<Policy>::Register(Callable<Event> a_callable,
+                                const int32_t& a_sortIndex)
+{
+    return Get<Event>().Register(std::move(a_callable), a_sortIndex);
+}
+
+//--------------------------------------------------------------
+//! Registers a callable to invoke when events of a type are
+//! dispatched.
+//!
+//! \tparam Event Type of the events to invoke the callable for.
+//! \param[in] a_callable A callable object that will be invoked.
+//! \param[in] a_sortIndex Order in which to invoke the callable.
+//! \return Connection to retain while callable should be invoked.
+//!         Destroy or disconnect it to 'deregister' the callable.
+//--------------------------------------------------------------
+template<class Policy>
+template<class Event> inline
+typename BasicEventBus<Policy>::template Connection<Event>
+BasicEventBus<Policy>::Connect(Callable<Event> a_callable,
+                               const int32_t& a_sortIndex)
+{
+    return Get<Event>().Connect(std::move(a_callable), a_sortIndex);
+}
+
+//--------------------------------------------------------------
+//! Remove a listener so not invoked when events are dispatched.
+//!
+//! \tparam Event Type of the events the listener was registered for.
+//! \param[in] a_listener Listener object to stop being invoked.
+//! \return True if the listener was removed or false otherwise.
+//--------------------------------------------------------------
+template<class Policy>
+template<class Event> inline
+bool BasicEventBus<Policy>::Remove(const Listener<Event>& a_listener)
+{
+    Dispatcher<Event>* dispatcher = Find<Event>();
+    return dispatcher && dispatcher->Remove(a_listener);
+}
+
+//--------------------------------------------------------------
+//! Remove a connection so not invoked when events are dispatched.
+//!
+//! \tparam Event Type of the events the connection was registered for.
+//! \param[in] a_connection Connection object to stop being invoked.
+//! \return True if the connection was removed or false otherwise.
+//--------------------------------------------------------------
+template<class Policy>
+template<class Event> inline
+bool BasicEventBus<Policy>::Remove(const Connection<Event>& a_connection)
+{
+    Dispatcher<Event>* dispatcher = Find<Event>();
+    return dispatcher && dispatcher->Remove(a_connection);
+}
+
+//--------------------------------------------------------------
+//! Sequentially dispatches an event to all listeners registered for
+//! its type (see Dispatcher::Dispatch). Does nothing if no listener
+//! has ever been registered for the type.
+//!
+//! \tparam Event Type of the event, used to find its dispatcher.
+//! \param[in] a_event Event passed by reference to listeners.
+//--------------------------------------------------------------
+template<class Policy>
+template<class Event> inline
+void BasicEventBus<Policy>::Dispatch(const Event& a_event)
+{
+    if (Dispatcher<Event>* dispatcher = Find<Event>())
+    {
+        dispatcher->Dispatch(a_event);
+    }
+}
+
+//--------------------------------------------------------------
+//! Gets the dispatcher for a type of event, creating it if needed,
+//! which gives access to the rest of its interface (eg. Enqueue).
+//!
+//! \tparam Event Type of the events to get the dispatcher for.
+//! \return Reference to the dispatcher for the type of event.
+//--------------------------------------------------------------
+template<class Policy>
+template<class Event> inline
+typename BasicEventBus<Policy>::template Dispatcher<Event>&
+BasicEventBus<Policy>::Get()
+{
+    if (Dispatcher<Event>* dispatcher = Find<Event>())
+    {
+        return *dispatcher;
+    }
+
+    const size_t typeIndex = TypeIndex<Event>();
+    if (typeIndex >= ChunkSize * ChunkCount)
+    {
+        throw std::length_error("Too many event types for BasicEventBus");
+    }
+
+    // Create the chunk and dispatcher, then publish them.
+    std::lock_guard<std::mutex> lock(m_chunksMutex);
+    std::atomic<Chunk*>& chunk = m_chunks[typeIndex / ChunkSize];
+    Chunk* holders = chunk.load(std::memory_order_relaxed);
+    if (!holders)
+    {
+        holders = new Chunk();
+        chunk.store(holders, std::memory_order_release);
+    }
+    std::atomic<Holder*>& holder = holders->m_holders[typeIndex % ChunkSize];
+    Holder* typed = holder.load(std::memory_order_relaxed);
+    if (!typed)
+    {
+        typed = new TypedHolder<Event>();
+        holder.store(typed, std::memory_order_release);
+    }
+    return static_cast<TypedHolder<Event>*>(typed)->m_dispatcher;
+}
+
+//--------------------------------------------------------------
+//! Finds the dispatcher for a type of event, without creating it.
+//!
+//! \tparam Event Type of the events to find the dispatcher for.
+//! \return Pointer to the dispatcher, or null if not yet created.
+//--------------------------------------------------------------
+template<class Policy>
+template<class Event> inline
+typename BasicEventBus<Policy>::template Dispatcher<Event>*
+BasicEventBus<Policy>::Find() const
+{
+    const size_t typeIndex = TypeIndex<Event>();
+    if (typeIndex >= ChunkSize * ChunkCount)
+    {
+        return nullptr;
+    }
+    const Chunk* holders = m_chunks[typeIndex / ChunkSize].load(std::memory_order_acquire);
+    if (!holders)
+    {
+        return nullptr;
+    }
+    Holder* holder = holders->m_holders[typeIndex % ChunkSize].load(std::memory_order_acquire);
+    return holder ? &static_cast<TypedHolder<Event>*>(holder)->m_dispatcher : nullptr;
+}
+
+//--------------------------------------------------------------
+//! Index of a type of event, assigned the first time it is used.
+//!
+//! \tparam Event Type of the events to get the index of.
+//! \return Index of the type, unique among all event types.
+//--------------------------------------------------------------
+template<class Policy>
+template<class Event> inline
+size_t BasicEventBus<Policy>::TypeIndex()
+{
+    static const size_t s_typeIndex = NextTypeIndex().fetch_add(1, std::memory_order_relaxed);
+    return s_typeIndex;
+}
+
+//--------------------------------------------------------------
+//! Index that will be assigned to the next type of event used.
+//!
+//! \return Reference to the next type index.
+//--------------------------------------------------------------
+template<class Policy> inline
+std::atomic<size_t>& BasicEventBus<Policy>::NextTypeIndex()
+{
+    static std::atomic<size_t> s_nextTypeIndex = { 0 };
+    return s_nextTypeIndex;
+}
+
+} // namespace Event
+} // namespace Simple
@@ -0,0 +1,189 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Event
+{
+
+//--------------------------------------------------------------
+//! Interface of an object that runs tasks (eg. on other threads),
+//! used by Dispatcher::DispatchAsync to deliver events. Implement
+//! it to hand events to an existing thread pool or job system.
+//--------------------------------------------------------------
+class Executor
+{
+public:
+    using Task = std::function<void()>;
+
+    virtual ~Executor() = default;
+
+    //----------------------------------------------------------
+    //! Runs a task, which must be run exactly once (at any time).
+    //!
+    //! \param[in] a_task Task to run.
+    //----------------------------------------------------------
+    virtual void Execute(Task a_task) = 0;
+
+    //----------------------------------------------------------
+    //! Number of tasks that the executor can run concurrently,
+    //! used to decide how many tasks to split parallel work into.
+    //!
+    //! \return Maximum number of tasks that may run at once.
+    //----------------------------------------------------------
+    virtual size_t Concurrency() const { return 1; }
+};
+
+//--------------------------------------------------------------
+//! Executor that runs tasks on a fixed number of worker threads,
+//! in the order that they were executed (tasks are taken from a
+//! single queue). Destroying the pool runs all remaining tasks,
+//! then joins the worker threads.
+//--------------------------------------------------------------
+class ThreadPool : public Executor
+{
+public:
+    explicit ThreadPool(size_t a_threadCount = std::thread::hardware_concurrency());
+    ~ThreadPool() override;
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Execute(Task a_task) override;
+    size_t Concurrency() const override;
+    size_t ThreadCount() const;
+
+    static ThreadPool& Default();
+
+private:
+    void Run();
+
+    std::deque<Task> m_tasks;
+    std::vector<std::thread> m_threads;
+    std::condition_variable m_tasksChanged;
+    std::mutex m_tasksMutex;
+    bool m_stopping = false;
+};
+
+//--------------------------------------------------------------
+//! Starts the worker threads.
+//!
+//! \param[in] a_threadCount Number of worker threads (at least 1).
+//--------------------------------------------------------------
+inline ThreadPool::ThreadPool(size_t a_threadCount)
+{
+    a_threadCount = std::max<size_t>(a_threadCount, 1);
+    m_threads.reserve(a_threadCount);
+    for (size_t i = 0; i < a_threadCount; ++i)
+    {
+        m_threads.emplace_back(&ThreadPool::Run, this);
+    }
+}
+
+//--------------------------------------------------------------
+//! Runs all remaining tasks, then joins the worker threads.
+//--------------------------------------------------------------
+inline ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_tasksMutex);
+        m_stopping = true;
+    }
+    m_tasksChanged.notify_all();
+    for (std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+//--------------------------------------------------------------
+//! Queues a task to be run by the next available worker thread.
+//!
+//! \param[in] a_task Task to run.
+//--------------------------------------------------------------
+inline void ThreadPool::Execute(Task a_task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_tasksMutex);
+        m_tasks.push_back(std::move(a_task));
+    }
+    m_tasksChanged.notify_one();
+}
+
+//--------------------------------------------------------------
+//! Number of tasks that can run concurrently (one per thread).
+//!
+//! \return Number of worker threads.
+//--------------------------------------------------------------
+inline size_t ThreadPool::Concurrency() const
+{
+    return ThreadCount();
+}
+
+//--------------------------------------------------------------
+//! Number of worker threads that run tasks.
+//!
+//! \return Number of worker threads.
+//--------------------------------------------------------------
+inline size_t ThreadPool::ThreadCount() const
+{
+    return m_threads.size();
+}
+
+//--------------------------------------------------------------
+//! Thread pool shared by all dispatchers that are not given an
+//! executor, with one worker thread per hardware thread. It is
+//! created when first used, and destroyed when the program exits.
+//!
+//! \return Reference to the default thread pool.
+//--------------------------------------------------------------
+inline ThreadPool& ThreadPool::Default()
+{
+    static ThreadPool s_threadPool;
+    return s_threadPool;
+}
+
+//--------------------------------------------------------------
+//! Worker thread loop, which runs tasks until the pool is being
+//! destroyed and no tasks remain.
+//--------------------------------------------------------------
+inline void ThreadPool::Run()
+{
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_tasksMutex);
+            m_tasksChanged.wait(lock, [this]()
+            {
+                return m_stopping || !m_tasks.empty();
+            });
+            if (m_tasks.empty())
+            {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+} // namespace Event
+} // namespace Simple
@@ -0,0 +1,292 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Event
+{
+
+//--------------------------------------------------------------
+//! Class that protects an object (published through an atomic
+//! pointer) from being reclaimed while the calling thread reads
+//! it, without modifying any state shared with other threads.
+//!
+//! Each hazard pointer owns a record, cache line aligned, which is
+//! only written by the thread that acquired it. Records are kept
+//! in a thread local free list after use, and are handed to other
+//! threads when the thread exits, so acquiring one is cheap too.
+//!
+//! Writers replace the published pointer then retire the object
+//! that it previously pointed to, which is only deleted by calling
+//! Reclaim once no hazard pointer protects it (the retired object
+//! should stay in the retired list until Reclaim deletes it).
+//--------------------------------------------------------------
+class HazardPointer
+{
+public:
+    HazardPointer();
+    ~HazardPointer();
+
+    HazardPointer(const HazardPointer&) = delete;
+    HazardPointer& operator=(const HazardPointer&) = delete;
+
+    template<class Type>
+    Type* Protect(const std::atomic<Type*>& a_source);
+    void Reset();
+
+    static void Reserve(size_t a_count);
+
+    template<class Type, class Allocator, class Deleter = std::default_delete<Type>>
+    static void Reclaim(std::vector<Type*, Allocator>& a_retired,
+                        Deleter a_deleter = Deleter());
+
+private:
+    struct alignas(64) Record
+    {
+        std::atomic<const void*> m_pointer = { nullptr };
+        std::atomic<bool> m_active = { true };
+        Record* m_next = nullptr;
+        Record* m_nextFree = nullptr;
+    };
+
+    struct ThreadRecords
+    {
+        ~ThreadRecords();
+        Record* m_free = nullptr;
+    };
+
+    static std::atomic<Record*>& Records();
+    static ThreadRecords& LocalRecords();
+    static Record* Acquire();
+    static void Release(Record* a_record);
+
+    Record* const m_record;
+};
+
+//--------------------------------------------------------------
+//! Acquires a hazard record for the calling thread.
+//--------------------------------------------------------------
+inline HazardPointer::HazardPointer()
+    : m_record(Acquire())
+{
+}
+
+//--------------------------------------------------------------
+//! Stops protecting the pointer, and releases the hazard record.
+//--------------------------------------------------------------
+inline HazardPointer::~HazardPointer()
+{
+    Release(m_record);
+}
+
+//--------------------------------------------------------------
+//! Loads a pointer and protects the object that it points to, so
+//! it will not be reclaimed until this is reset or destroyed.
+//!
+//! \param[in] a_source Atomic pointer to an object to protect.
+//! \return Pointer to the protected object, which may be null.
+//--------------------------------------------------------------
+template<class Type> inline
+Type* HazardPointer::Protect(const std::atomic<Type*>& a_source)
+{
+    // Publish the hazard, then make sure the pointer is still the
+    // current one; if not it may already be retired so try again.
+    Type* pointer = a_source.load(std::memory_order_acquire);
+    while (true)
+    {
+        m_record->m_pointer.store(pointer, std::memory_order_seq_cst);
+        Type* current = a_source.load(std::memory_order_seq_cst);
+        if (current == pointer)
+        {
+            return pointer;
+        }
+        pointer = current;
+    }
+}
+
+//--------------------------------------------------------------
+//! Stops protecting the pointer, allowing it to be reclaimed.
+//--------------------------------------------------------------
+inline void HazardPointer::Reset()
+{
+    m_record->m_pointer.store(nullptr, std::memory_order_release);
+}
+
+//--------------------------------------------------------------
+//! Makes sure the calling thread owns at least a number of free
+//! hazard records, so that up to that many hazard pointers can be
+//! used at once (eg. by nested dispatches) without allocating.
+//!
+//! \param[in] a_count Number of hazard records to reserve.
+//--------------------------------------------------------------
+inline void HazardPointer::Reserve(size_t a_count)
+{
+    // Hold the records, so each is a different one, then free them.
+    Record* held = nullptr;
+    for (size_t i = 0; i < a_count; ++i)
+    {
+        Record* record = Acquire();
+        record->m_nextFree = held;
+        held = record;
+    }
+    while (Record* record = held)
+    {
+        held = record->m_nextFree;
+        Release(record);
+    }
+}
+
+//--------------------------------------------------------------
+//! Deletes all retired objects that are no longer protected by
+//! a hazard pointer, and removes them from the retired list.
+//! Calls must be serialized by the caller (eg. with a mutex).
+//!
+//! \param[in,out] a_retired Objects that were retired by writers.
+//! \param[in] a_deleter Function called to delete each object.
+//--------------------------------------------------------------
+template<class Type, class Allocator, class Deleter> inline
+void HazardPointer::Reclaim(std::vector<Type*, Allocator>& a_retired,
+                            Deleter a_deleter)
+{
+    if (a_retired.empty())
+    {
+        return;
+    }
+
+    // Gather the pointers currently protected by any thread (into
+    // scratch space that each thread reuses, to avoid allocating).
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    static thread_local std::vector<const void*> s_hazards;
+    std::vector<const void*>& hazards = s_hazards;
+    hazards.clear();
+    Record* record = Records().load(std::memory_order_acquire);
+    for (; record; record = record->m_next)
+    {
+        if (const void* hazard = record->m_pointer.load(std::memory_order_seq_cst))
+        {
+            hazards.push_back(hazard);
+        }
+    }
+    std::sort(hazards.begin(), hazards.end());
+
+    // Delete the retired objects that are not protected.
+    auto it = std::remove_if(a_retired.begin(), a_retired.end(),
+                             [&hazards, &a_deleter](Type* a_object)
+    {
+        if (std::binary_search(hazards.begin(), hazards.end(), a_object))
+        {
+            return false;
+        }
+        a_deleter(a_object);
+        return true;
+    });
+    a_retired.erase(it, a_retired.end());
+}
+
+//--------------------------------------------------------------
+//! List of all hazard records ever created, which is only added
+//! to (records are reused but never freed, as readers may still
+//! be scanning them), so it is bounded by peak thread usage.
+//!
+//! \return Reference to the head of the list of hazard records.
+//--------------------------------------------------------------
+inline std::atomic<HazardPointer::Record*>& HazardPointer::Records()
+{
+    static std::atomic<Record*> s_records = { nullptr };
+    return s_records;
+}
+
+//--------------------------------------------------------------
+//! Hazard records that are owned by (and free to use on) the
+//! calling thread, so nested hazard pointers can reuse them.
+//!
+//! \return Reference to the free records of the calling thread.
+//--------------------------------------------------------------
+inline HazardPointer::ThreadRecords& HazardPointer::LocalRecords()
+{
+    static thread_local ThreadRecords s_threadRecords;
+    return s_threadRecords;
+}
+
+//--------------------------------------------------------------
+//! Hands all records owned by the thread to any other threads.
+//--------------------------------------------------------------
+inline HazardPointer::ThreadRecords::~ThreadRecords()
+{
+    while (Record* record = m_free)
+    {
+        m_free = record->m_nextFree;
+        record->m_active.store(false, std::memory_order_release);
+    }
+}
+
+//--------------------------------------------------------------
+//! Acquires a record, from the thread's free list if possible,
+//! otherwise by reusing an inactive record or creating a new one.
+//!
+//! \return Hazard record for the exclusive use of this thread.
+//--------------------------------------------------------------
+inline HazardPointer::Record* HazardPointer::Acquire()
+{
+    ThreadRecords& threadRecords = LocalRecords();
+    if (Record* record = threadRecords.m_free)
+    {
+        threadRecords.m_free = record->m_nextFree;
+        return record;
+    }
+
+    // Try to reuse a record that was handed back by a thread.
+    std::atomic<Record*>& records = Records();
+    Record* record = records.load(std::memory_order_acquire);
+    for (; record; record = record->m_next)
+    {
+        bool active = false;
+        if (!record->m_active.load(std::memory_order_relaxed) &&
+            record->m_active.compare_exchange_strong(active, true))
+        {
+            return record;
+        }
+    }
+
+    // Otherwise create a new record and add it to the list.
+    record = new Record();
+    Record* head = records.load(std::memory_order_relaxed);
+    do
+    {
+        record->m_next = head;
+    }
+    while (!records.compare_exchange_weak(head, record,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+    return record;
+}
+
+//--------------------------------------------------------------
+//! Clears a record and adds it to the thread's free list.
+//!
+//! \param[in] a_record Hazard record acquired by this thread.
+//--------------------------------------------------------------
+inline void HazardPointer::Release(Record* a_record)
+{
+    a_record->m_pointer.store(nullptr, std::memory_order_release);
+    ThreadRecords& threadRecords = LocalRecords();
+    a_record->m_nextFree = threadRecords.m_free;
+    threadRecords.m_free = a_record;
+}
+
+} // namespace Event
+} // namespace Simple
@@ -0,0 +1,412 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Event
+{
+
+//--------------------------------------------------------------
+//! Template class that stores a callable object (much like the
+//! std::function class template), except that the callable is
+//! always stored inline and the object never allocates memory.
+//!
+//! Assigning a callable that is larger than the capacity (or is
+//! over-aligned) is a compile error, rather than a heap fallback.
+//! Calls are made through a single function pointer, so invoking
+//! an InplaceFunction costs one indirect jump; calling one that
+//! is empty throws std::bad_function_call, like std::function.
+//!
+//! \tparam Signature Function signature, eg. Status(const int&).
+//! \tparam Capacity Size in bytes of the inline callable storage.
+//! \tparam Copyable Whether copyable (or move-only) if false, in
+//!         which case move-only callables can also be assigned.
+//--------------------------------------------------------------
+template<class Signature,
+         size_t Capacity = 4 * sizeof(void*),
+         bool Copyable = true>
+class InplaceFunction;
+
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable>
+class InplaceFunction<Result(Params...), Capacity, Copyable>
+{
+    // Type that replaces the copy parameter when not copyable,
+    // so the implicit copy operations are deleted by the moves.
+    struct NotCopyable {};
+    using CopySource = typename std::conditional<Copyable,
+                                                 const InplaceFunction&,
+                                                 const NotCopyable&>::type;
+
+    // Whether a callable can be invoked with the parameters, and
+    // returns a value convertible to the result (or it is void).
+    template<class Function, class = void>
+    struct IsCallable : std::false_type {};
+    template<class Function>
+    struct IsCallable<Function, decltype(void(std::declval<Function&>()(std::declval<Params>()...)))>
+        : std::integral_constant<bool,
+              std::is_void<Result>::value ||
+              std::is_convertible<decltype(std::declval<Function&>()(std::declval<Params>()...)),
+                                  Result>::value> {};
+
+    // Enable the converting constructor for all callable types,
+    // excluding InplaceFunction itself (use copy/move instead).
+    template<class Function>
+    using EnableIfCallable = typename std::enable_if<
+        !std::is_same<typename std::decay<Function>::type,
+                      InplaceFunction>::value &&
+        IsCallable<typename std::decay<Function>::type>::value>::type;
+
+public:
+    InplaceFunction() noexcept;
+    InplaceFunction(std::nullptr_t) noexcept;
+    InplaceFunction(CopySource a_other);
+    InplaceFunction(InplaceFunction&& a_other);
+    template<class Function, class = EnableIfCallable<Function>>
+    InplaceFunction(Function&& a_function);
+    ~InplaceFunction();
+
+    InplaceFunction& operator=(CopySource a_other);
+    InplaceFunction& operator=(InplaceFunction&& a_other);
+    InplaceFunction& operator=(std::nullptr_t) noexcept;
+
+    explicit operator bool() const noexcept;
+    Result operator()(Params... a_params) const;
+
+private:
+    enum class Operation
+    {
+        Copy,
+        Move,
+        Destroy
+    };
+    using Invoker = Result(*)(void*, Params&&...);
+    using Manager = void(*)(Operation, void*, void*);
+
+    template<class Function>
+    static Result Invoke(void* a_storage, Params&&... a_params);
+    static Result InvokeEmpty(void* a_storage, Params&&... a_params);
+
+    template<class Function>
+    static void Manage(Operation a_operation,
+                       void* a_destination,
+                       void* a_source);
+    template<class Function>
+    static void Copy(void* a_destination,
+                     void* a_source,
+                     std::true_type a_copyable);
+    template<class Function>
+    static void Copy(void* a_destination,
+                     void* a_source,
+                     std::false_type a_copyable);
+
+    template<class Function>
+    static bool IsNull(const Function& a_function,
+                       std::true_type a_nullable);
+    template<class Function>
+    static bool IsNull(const Function& a_function,
+                       std::false_type a_nullable);
+
+    void Assign(const InplaceFunction& a_other);
+    void Assign(InplaceFunction&& a_other);
+    void Reset();
+
+    Invoker m_invoke;
+    Manager m_manage;
+    alignas(std::max_align_t) mutable unsigned char m_storage[Capacity];
+};
+
+//--------------------------------------------------------------
+//! Constructs an empty function.
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable> inline
+InplaceFunction<Result(Params...), Capacity, Copyable>::InplaceFunction() noexcept
+    : m_invoke(&InvokeEmpty)
+    , m_manage(nullptr)
+{
+}
+
+//--------------------------------------------------------------
+//! Constructs an empty function.
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable> inline
+InplaceFunction<Result(Params...), Capacity, Copyable>::InplaceFunction(std::nullptr_t) noexcept
+    : InplaceFunction()
+{
+}
+
+//--------------------------------------------------------------
+//! Constructs a copy of another function (and its callable).
+//!
+//! \param[in] a_other Function to copy, only if Copyable is true.
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable> inline
+InplaceFunction<Result(Params...), Capacity, Copyable>::InplaceFunction(CopySource a_other)
+    : InplaceFunction()
+{
+    Assign(a_other);
+}
+
+//--------------------------------------------------------------
+//! Constructs a function by moving the callable of another one.
+//!
+//! \param[in] a_other Function to move, which is left empty.
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable> inline
+InplaceFunction<Result(Params...), Capacity, Copyable>::InplaceFunction(InplaceFunction&& a_other)
+    : InplaceFunction()
+{
+    Assign(std::move(a_other));
+}
+
+//--------------------------------------------------------------
+//! Constructs a function storing a copy of the callable inline.
+//! A null function pointer results in an empty function object.
+//!
+//! \param[in] a_function Callable object to store and invoke.
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable>
+template<class Function, class> inline
+InplaceFunction<Result(Params...), Capacity, Copyable>::InplaceFunction(Function&& a_function)
+    : InplaceFunction()
+{
+    using Stored = typename std::decay<Function>::type;
+    static_assert(sizeof(Stored) <= Capacity,
+                  "Callable is too large for the InplaceFunction capacity");
+    static_assert(alignof(Stored) <= alignof(std::max_align_t),
+                  "Callable is over-aligned for the InplaceFunction storage");
+    static_assert(!Copyable || std::is_copy_constructible<Stored>::value,
+                  "Callable must be copyable unless InplaceFunction is move-only");
+
+    using Nullable = std::is_pointer<Stored>;
+    if (IsNull<Stored>(a_function, Nullable()))
+    {
+        return;
+    }
+
+    ::new (static_cast<void*>(m_storage)) Stored(std::forward<Function>(a_function));
+    m_invoke = &Invoke<Stored>;
+    m_manage = &Manage<Stored>;
+}
+
+//--------------------------------------------------------------
+//! Destroys the stored callable (if any).
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable> inline
+InplaceFunction<Result(Params...), Capacity, Copyable>::~InplaceFunction()
+{
+    Reset();
+}
+
+//--------------------------------------------------------------
+//! Replaces the stored callable with a copy of another's.
+//!
+//! \param[in] a_other Function to copy, only if Copyable is true.
+//! \return Reference to this function.
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable> inline
+InplaceFunction<Result(Params...), Capacity, Copyable>&
+InplaceFunction<Result(Params...), Capacity, Copyable>::operator=(CopySource a_other)
+{
+    if (this != &a_other)
+    {
+        Reset();
+        Assign(a_other);
+    }
+    return *this;
+}
+
+//--------------------------------------------------------------
+//! Replaces the stored callable by moving the callable of another.
+//!
+//! \param[in] a_other Function to move, which is left empty.
+//! \return Reference to this function.
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable> inline
+InplaceFunction<Result(Params...), Capacity, Copyable>&
+InplaceFunction<Result(Params...), Capacity, Copyable>::operator=(InplaceFunction&& a_other)
+{
+    if (this != &a_other)
+    {
+        Reset();
+        Assign(std::move(a_other));
+    }
+    return *this;
+}
+
+//--------------------------------------------------------------
+//! Destroys the stored callable (if any), leaving this empty.
+//!
+//! \return Reference to this function.
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable> inline
+InplaceFunction<Result(Params...), Capacity, Copyable>&
+InplaceFunction<Result(Params...), Capacity, Copyable>::operator=(std::nullptr_t) noexcept
+{
+    Reset();
+    return *this;
+}
+
+//--------------------------------------------------------------
+//! Checks whether a callable is stored.
+//!
+//! \return True if a callable is stored or false if empty.
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable> inline
+InplaceFunction<Result(Params...), Capacity, Copyable>::operator bool() const noexcept
+{
+    return m_manage != nullptr;
+}
+
+//--------------------------------------------------------------
+//! Invokes the stored callable.
+//!
+//! \param[in] a_params Parameters forwarded to the callable.
+//! \return Result of invoking the callable.
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable> inline
+Result InplaceFunction<Result(Params...), Capacity, Copyable>::operator()(Params... a_params) const
+{
+    return m_invoke(m_storage, std::forward<Params>(a_params)...);
+}
+
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable>
+template<class Function> inline
+Result InplaceFunction<Result(Params...), Capacity, Copyable>::Invoke(void* a_storage,
+                                                                     Params&&... a_params)
+{
+    return static_cast<Result>((*static_cast<Function*>(a_storage))(std::forward<Params>(a_params)...));
+}
+
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable> inline
+Result InplaceFunction<Result(Params...), Capacity, Copyable>::InvokeEmpty(void*,
+                                                                          Params&&...)
+{
+    throw std::bad_function_call();
+}
+
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable>
+template<class Function> inline
+void InplaceFunction<Result(Params...), Capacity, Copyable>::Manage(Operation a_operation,
+                                                                   void* a_destination,
+                                                                   void* a_source)
+{
+    switch (a_operation)
+    {
+        case Operation::Copy:
+        {
+            Copy<Function>(a_destination,
+                           a_source,
+                           std::integral_constant<bool, Copyable>());
+        }
+        break;
+        case Operation::Move:
+        {
+            Function* source = static_cast<Function*>(a_source);
+            ::new (a_destination) Function(std::move(*source));
+            source->~Function();
+        }
+        break;
+        case Operation::Destroy:
+        {
+            static_cast<Function*>(a_destination)->~Function();
+        }
+        break;
+    }
+}
+
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable>
+template<class Function> inline
+void InplaceFunction<Result(Params...), Capacity, Copyable>::Copy(void* a_destination,
+                                                                 void* a_source,
+                                                                 std::true_type)
+{
+    ::new (a_destination) Function(*static_cast<const Function*>(a_source));
+}
+
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable>
+template<class Function> inline
+void InplaceFunction<Result(Params...), Capacity, Copyable>::Copy(void*,
+                                                                 void*,
+                                                                 std::false_type)
+{
+    // Never called, move-only functions cannot be copied.
+}
+
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable>
+template<class Function> inline
+bool InplaceFunction<Result(Params...), Capacity, Copyable>::IsNull(const Function& a_function,
+                                                                   std::true_type)
+{
+    return a_function == nullptr;
+}
+
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable>
+template<class Function> inline
+bool InplaceFunction<Result(Params...), Capacity, Copyable>::IsNull(const Function&,
+                                                                   std::false_type)
+{
+    return false;
+}
+
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable> inline
+void InplaceFunction<Result(Params...), Capacity, Copyable>::Assign(const InplaceFunction& a_other)
+{
+    if (a_other.m_manage)
+    {
+        a_other.m_manage(Operation::Copy, m_storage, a_other.m_storage);
+        m_invoke = a_other.m_invoke;
+        m_manage = a_other.m_manage;
+    }
+}
+
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable> inline
+void InplaceFunction<Result(Params...), Capacity, Copyable>::Assign(InplaceFunction&& a_other)
+{
+    if (a_other.m_manage)
+    {
+        a_other.m_manage(Operation::Move, m_storage, a_other.m_storage);
+        m_invoke = a_other.m_invoke;
+        m_manage = a_other.m_manage;
+        a_other.m_invoke = &InvokeEmpty;
+        a_other.m_manage = nullptr;
+    }
+}
+
+//--------------------------------------------------------------
+template<class Result, class... Params, size_t Capacity, bool Copyable> inline
+void InplaceFunction<Result(Params...), Capacity, Copyable>::Reset()
+{
+    if (m_manage)
+    {
+        m_manage(Operation::Destroy, m_storage, nullptr);
+        m_invoke = &InvokeEmpty;
+        m_manage = nullptr;
+    }
+}
+
+} // namespace Event
+} // namespace Simple
@@ -0,0 +1,506 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <simple/event/dispatcher.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Event
+{
+
+//--------------------------------------------------------------
+//! Template class that routes events to listeners by key (eg. an
+//! event type or entity id), so dispatching an event only touches
+//! the listeners registered for its key, plus wildcard listeners
+//! registered for every key, rather than filtering all listeners.
+//!
+//! Listeners for each key are kept by a Dispatcher of their own,
+//! found through a fixed table of hash buckets. Each bucket is an
+//! immutable array of keys (guarded just like a snapshot of the
+//! listeners, by the locking model of the policy), so dispatching
+//! never locks a mutex (by default), and registering a new key only
+//! copies the keys in its bucket.
+//! Listeners of the key and wildcard listeners are merged by their
+//! sort index (keyed listeners first, if they share a sort index),
+//! and dispatching ends once a listener consumes the event.
+//!
+//! Keys keep their dispatcher after all of their listeners have
+//! been released (so a key can be reused cheaply); call Prune to
+//! drop the dispatchers of keys that have no listeners left.
+//!
+//! \tparam Policy Class that defines how callables are stored.
+//! \tparam Key Type of the keys, which must be hashable (std::hash).
+//! \tparam Args Parameter pack that defines the event signature.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args>
+class BasicKeyedDispatcher
+{
+public:
+    using Dispatcher = BasicDispatcher<Policy, Args...>;
+    using Callable = typename Dispatcher::Callable;
+    using Connection = typename Dispatcher::Connection;
+    using Listener = typename Dispatcher::Listener;
+    using Filter = typename Dispatcher::Filter;
+
+    explicit BasicKeyedDispatcher(size_t a_bucketCount = 64);
+    ~BasicKeyedDispatcher();
+
+    BasicKeyedDispatcher(const BasicKeyedDispatcher&) = delete;
+    BasicKeyedDispatcher& operator=(const BasicKeyedDispatcher&) = delete;
+
+    [[nodiscard]]
+    Listener Register(const Key& a_key,
+                      Callable a_callable,
+                      const int32_t& a_sortIndex = 0);
+    [[nodiscard]]
+    Connection Connect(const Key& a_key,
+                       Callable a_callable,
+                       const int32_t& a_sortIndex = 0);
+    bool Remove(const Key& a_key,
+                const Listener& a_listener);
+    bool Remove(const Key& a_key,
+                const Connection& a_connection);
+
+    [[nodiscard]]
+    Listener RegisterWildcard(Callable a_callable,
+                              const int32_t& a_sortIndex = 0);
+    [[nodiscard]]
+    Connection ConnectWildcard(Callable a_callable,
+                               const int32_t& a_sortIndex = 0);
+    bool RemoveWildcard(const Listener& a_listener);
+    bool RemoveWildcard(const Connection& a_connection);
+
+    void Dispatch(const Key& a_key,
+                  const Args&... a_args);
+    size_t Prune();
+
+private:
+    using Entry = typename Dispatcher::Entry;
+    using Snapshot = typename Dispatcher::Snapshot;
+    using Locking = typename Dispatcher::Locking;
+    using Mutex = typename Dispatcher::Mutex;
+    using Bucket = std::vector<std::pair<Key, std::shared_ptr<Dispatcher>>>;
+
+    static size_t RoundUp(size_t a_bucketCount);
+    std::atomic<Bucket*>& FindBucket(const Key& a_key) const;
+    Dispatcher* Find(const Key& a_key) const;
+    Dispatcher& FindOrAdd(const Key& a_key);
+    void Publish(std::atomic<Bucket*>& a_bucket,
+                 Bucket* a_keys);
+
+    const size_t m_mask;
+    const std::unique_ptr<std::atomic<Bucket*>[]> m_buckets;
+    std::vector<Bucket*> m_retired;
+    mutable typename Locking::Readers m_readers;
+    Mutex m_keysMutex;
+    Dispatcher m_wildcard;
+};
+
+//--------------------------------------------------------------
+//! Keyed dispatcher that stores callables using the default policy.
+//!
+//! \tparam Key Type of the keys, which must be hashable (std::hash).
+//! \tparam Args Parameter pack that defines the event signature.
+//--------------------------------------------------------------
+template<class Key, class... Args>
+using KeyedDispatcher = BasicKeyedDispatcher<DefaultPolicy, Key, Args...>;
+
+//--------------------------------------------------------------
+//! Creates the table of buckets, rounding the number of buckets up
+//! to a power of two. Small integer keys (eg. less than the number
+//! of buckets) each get a bucket of their own with std::hash.
+//!
+//! \param[in] a_bucketCount Minimum number of hash buckets.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+BasicKeyedDispatcher<Policy, Key, Args...>::BasicKeyedDispatcher(size_t a_bucketCount)
+    : m_mask(RoundUp(a_bucketCount) - 1)
+    , m_buckets(new std::atomic<Bucket*>[RoundUp(a_bucketCount)])
+{
+    for (size_t i = 0; i <= m_mask; ++i)
+    {
+        m_buckets[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+//--------------------------------------------------------------
+//! Destroys the dispatcher, which must not be dispatching events.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+BasicKeyedDispatcher<Policy, Key, Args...>::~BasicKeyedDispatcher()
+{
+    for (size_t i = 0; i <= m_mask; ++i)
+    {
+        delete m_buckets[i].load(std::memory_order_relaxed);
+    }
+    for (Bucket* bucket : m_retired)
+    {
+        delete bucket;
+    }
+}
+
+//--------------------------------------------------------------
+//! Registers a callable to invoke when events with a key are
+//! dispatched.
+//!
+//! \param[in] a_key Key of the events to invoke the callable for.
+//! \param[in] a_callable A callable object that will be invoked.
+//! \param[in] a_sortIndex Order in which to invoke the callable.
+//! \return Listener to retain while callable should be invoked.
+//!         Release all references to 'deregister' the callable.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+typename BasicKeyedDispatcher<Policy, Key, Args...>::Listener
+BasicKeyedDispatcher<Policy, Key, Args...>::Register(const Key& a_key,
+                                                     Callable a_callable,
+                                                     const int32_t& a_sortIndex)
+{
+    std::lock_guard<Mutex> lock(m_keysMutex);
+    return FindOrAdd(a_key).Register(std::move(a_callable), a_sortIndex);
+}
+
+//--------------------------------------------------------------
+//! Registers a callable to invoke when events with a key are
+//! dispatched.
+//!
+//! \param[in] a_key Key of the events to invoke the callable for.
+//! \param[in] a_callable A callable object that will be invoked.
+//! \param[in] a_sortIndex Order in which to invoke the callable.
+//! \return Connection to retain while callable should be invoked.
+//!         Destroy or disconnect it to 'deregister' the callable.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+typename BasicKeyedDispatcher<Policy, Key, Args...>::Connection
+BasicKeyedDispatcher<Policy, Key, Args...>::Connect(const Key& a_key,
+                                                    Callable a_callable,
+                                                    const int32_t& a_sortIndex)
+{
+    std::lock_guard<Mutex> lock(m_keysMutex);
+    return FindOrAdd(a_key).Connect(std::move(a_callable), a_sortIndex);
+}
+
+//--------------------------------------------------------------
+//! Remove a listener so not invoked when events are dispatched.
+//!
+//! \param[in] a_key Key that the listener was registered with.
+//! \param[in] a_listener Listener object to stop being invoked.
+//! \return True if the listener was removed or false otherwise.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+bool BasicKeyedDispatcher<Policy, Key, Args...>::Remove(const Key& a_key,
+                                                        const Listener& a_listener)
+{
+    std::lock_guard<Mutex> lock(m_keysMutex);
+    Dispatcher* dispatcher = Find(a_key);
+    return dispatcher && dispatcher->Remove(a_listener);
+}
+
+//--------------------------------------------------------------
+//! Remove a connection so not invoked when events are dispatched.
+//!
+//! \param[in] a_key Key that the connection was registered with.
+//! \param[in] a_connection Connection object to stop being invoked.
+//! \return True if the connection was removed or false otherwise.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+bool BasicKeyedDispatcher<Policy, Key, Args...>::Remove(const Key& a_key,
+                                                        const Connection& a_connection)
+{
+    std::lock_guard<Mutex> lock(m_keysMutex);
+    Dispatcher* dispatcher = Find(a_key);
+    return dispatcher && dispatcher->Remove(a_connection);
+}
+
+//--------------------------------------------------------------
+//! Registers a callable to invoke when events with any key are
+//! dispatched.
+//!
+//! \param[in] a_callable A callable object that will be invoked.
+//! \param[in] a_sortIndex Order in which to invoke the callable.
+//! \return Listener to retain while callable should be invoked.
+//!         Release all references to 'deregister' the callable.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+typename BasicKeyedDispatcher<Policy, Key, Args...>::Listener
+BasicKeyedDispatcher<Policy, Key, Args...>::RegisterWildcard(Callable a_callable,
+                                                             const int32_t& a_sortIndex)
+{
+    return m_wildcard.Register(std::move(a_callable), a_sortIndex);
+}
+
+//--------------------------------------------------------------
+//! Registers a callable to invoke when events with any key are
+//! dispatched.
+//!
+//! \param[in] a_callable A callable object that will be invoked.
+//! \param[in] a_sortIndex Order in which to invoke the callable.
+//! \return Connection to retain while callable should be invoked.
+//!         Destroy or disconnect it to 'deregister' the callable.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+typename BasicKeyedDispatcher<Policy, Key, Args...>::Connection
+BasicKeyedDispatcher<Policy, Key, Args...>::ConnectWildcard(Callable a_callable,
+                                                            const int32_t& a_sortIndex)
+{
+    return m_wildcard.Connect(std::move(a_callable), a_sortIndex);
+}
+
+//--------------------------------------------------------------
+//! Remove a wildcard listener so not invoked for any events.
+//!
+//! \param[in] a_listener Listener object to stop being invoked.
+//! \return True if the listener was removed or false otherwise.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+bool BasicKeyedDispatcher<Policy, Key, Args...>::RemoveWildcard(const Listener& a_listener)
+{
+    return m_wildcard.Remove(a_listener);
+}
+
+//--------------------------------------------------------------
+//! Remove a wildcard connection so not invoked for any events.
+//!
+//! \param[in] a_connection Connection object to stop being invoked.
+//! \return True if the connection was removed or false otherwise.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+bool BasicKeyedDispatcher<Policy, Key, Args...>::RemoveWildcard(const Connection& a_connection)
+{
+    return m_wildcard.Remove(a_connection);
+}
+
+//--------------------------------------------------------------
+//! Sequentially dispatches an event to all listeners registered
+//! with its key and all wildcard listeners, merged by sort index.
+//! If a listener returns Status::Consumed the dispatch will end,
+//! and no remaining (lower priority) listeners shall be invoked.
+//!
+//! \param[in] a_key Key of the event, used to find its listeners.
+//! \param[in] a_args Arguments passed by reference to listeners.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+void BasicKeyedDispatcher<Policy, Key, Args...>::Dispatch(const Key& a_key,
+                                                          const Args&... a_args)
+{
+    const DispatchDepth depth;
+
+    // Grab the snapshots of the key and wildcard listeners, while
+    // the bucket keeps the dispatcher of the key from being pruned.
+    const uint64_t epoch = Dispatcher::ExpiryEpoch().load(std::memory_order_acquire);
+    typename Locking::ReadGuard bucketGuard(m_readers);
+    std::optional<typename Locking::ReadGuard> keyedGuard;
+    typename Locking::ReadGuard wildcardGuard(m_wildcard.m_readers);
+    const Snapshot* keyed = nullptr;
+    if (const Bucket* bucket = bucketGuard.Protect(FindBucket(a_key)))
+    {
+        for (const std::pair<Key, std::shared_ptr<Dispatcher>>& key : *bucket)
+        {
+            if (key.first == a_key)
+            {
+                keyedGuard.emplace(key.second->m_readers);
+                keyed = keyedGuard->Protect(key.second->m_listeners);
+                break;
+            }
+        }
+    }
+    const Snapshot* wildcard = wildcardGuard.Protect(m_wildcard.m_listeners);
+
+    // Merge the listeners by sort index, keyed listeners first.
+    static const std::pmr::vector<Entry*> s_empty;
+    const std::pmr::vector<Entry*>& keyedEntries = keyed ? keyed->m_entries : s_empty;
+    const std::pmr::vector<Entry*>& wildcardEntries = wildcard ? wildcard->m_entries : s_empty;
+    size_t keyedIndex = 0;
+    size_t wildcardIndex = 0;
+    while (keyedIndex < keyedEntries.size() || wildcardIndex < wildcardEntries.size())
+    {
+        const bool useKeyed = wildcardIndex == wildcardEntries.size() ||
+                              (keyedIndex < keyedEntries.size() &&
+                               keyedEntries[keyedIndex]->m_sortIndex <=
+                               wildcardEntries[wildcardIndex]->m_sortIndex);
+        const Entry* entry = useKeyed ? keyedEntries[keyedIndex++] :
+                                        wildcardEntries[wildcardIndex++];
+        if (entry->Expired(epoch) || !entry->m_callable)
+        {
+            continue;
+        }
+        if (Dispatcher::Call(*entry, a_args...) == Status::Consumed)
+        {
+            // Stop sending the event.
+            break;
+        }
+    }
+}
+
+//--------------------------------------------------------------
+//! Drops the dispatchers of keys that have no listeners left, so
+//! that keys which are no longer used (eg. ids of entities which
+//! have been destroyed) stop taking up memory. Can be called from
+//! any thread (eg. a maintenance thread), while dispatching.
+//!
+//! \return Number of keys that were dropped.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+size_t BasicKeyedDispatcher<Policy, Key, Args...>::Prune()
+{
+    std::lock_guard<Mutex> lock(m_keysMutex);
+    size_t pruned = 0;
+    for (size_t i = 0; i <= m_mask; ++i)
+    {
+        const Bucket* bucket = m_buckets[i].load(std::memory_order_relaxed);
+        if (!bucket)
+        {
+            continue;
+        }
+
+        // Keep the keys which still have a registered listener.
+        Bucket* keys = new Bucket();
+        for (const std::pair<Key, std::shared_ptr<Dispatcher>>& key : *bucket)
+        {
+            const Snapshot* snapshot = key.second->m_listeners.load(std::memory_order_acquire);
+            const bool registered = snapshot &&
+                std::any_of(snapshot->m_entries.begin(), snapshot->m_entries.end(),
+                            [](const Entry* a_entry)
+            {
+                return !a_entry->m_expiredEpoch.load(std::memory_order_acquire);
+            });
+            if (registered)
+            {
+                keys->push_back(key);
+            }
+        }
+
+        if (keys->size() == bucket->size())
+        {
+            delete keys;
+            continue;
+        }
+        pruned += bucket->size() - keys->size();
+        if (keys->empty())
+        {
+            delete keys;
+            keys = nullptr;
+        }
+        Publish(m_buckets[i], keys);
+    }
+    return pruned;
+}
+
+//--------------------------------------------------------------
+//! Rounds a bucket count up to a power of two (of at least one),
+//! so buckets can be indexed by masking the hash of a key.
+//!
+//! \param[in] a_bucketCount Minimum number of hash buckets.
+//! \return Number of hash buckets.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+size_t BasicKeyedDispatcher<Policy, Key, Args...>::RoundUp(size_t a_bucketCount)
+{
+    size_t bucketCount = 1;
+    while (bucketCount < a_bucketCount)
+    {
+        bucketCount *= 2;
+    }
+    return bucketCount;
+}
+
+//--------------------------------------------------------------
+//! Finds the bucket that a key belongs to.
+//!
+//! \param[in] a_key Key to find the bucket of.
+//! \return Reference to the atomic pointer to the bucket's keys.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+std::atomic<typename BasicKeyedDispatcher<Policy, Key, Args...>::Bucket*>&
+BasicKeyedDispatcher<Policy, Key, Args...>::FindBucket(const Key& a_key) const
+{
+    return m_buckets[std::hash<Key>()(a_key) & m_mask];
+}
+
+//--------------------------------------------------------------
+//! Finds the dispatcher of a key. Only call while holding the keys
+//! mutex (so that the dispatcher cannot be pruned meanwhile).
+//!
+//! \param[in] a_key Key to find the dispatcher of.
+//! \return Dispatcher of the key, or null if it has none.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+typename BasicKeyedDispatcher<Policy, Key, Args...>::Dispatcher*
+BasicKeyedDispatcher<Policy, Key, Args...>::Find(const Key& a_key) const
+{
+    if (const Bucket* bucket = FindBucket(a_key).load(std::memory_order_relaxed))
+    {
+        for (const std::pair<Key, std::shared_ptr<Dispatcher>>& key : *bucket)
+        {
+            if (key.first == a_key)
+            {
+                return key.second.get();
+            }
+        }
+    }
+    return nullptr;
+}
+
+//--------------------------------------------------------------
+//! Finds the dispatcher of a key, adding one if it has none yet by
+//! publishing a copy of its bucket with the key appended. Only call
+//! while holding the keys mutex (single writer).
+//!
+//! \param[in] a_key Key to find (or add) the dispatcher of.
+//! \return Dispatcher of the key.
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+typename BasicKeyedDispatcher<Policy, Key, Args...>::Dispatcher&
+BasicKeyedDispatcher<Policy, Key, Args...>::FindOrAdd(const Key& a_key)
+{
+    if (Dispatcher* dispatcher = Find(a_key))
+    {
+        return *dispatcher;
+    }
+
+    std::atomic<Bucket*>& bucket = FindBucket(a_key);
+    const Bucket* previous = bucket.load(std::memory_order_relaxed);
+    Bucket* keys = previous ? new Bucket(*previous) : new Bucket();
+    keys->emplace_back(a_key, std::make_shared<Dispatcher>());
+    Dispatcher& dispatcher = *keys->back().second;
+    Publish(bucket, keys);
+    return dispatcher;
+}
+
+//--------------------------------------------------------------
+//! Publishes the keys of a bucket, retiring the previous keys,
+//! which are deleted (along with the dispatchers of any keys that
+//! were pruned) once no longer being read by any dispatch.
+//! Only call while holding the keys mutex (single writer).
+//!
+//! \param[in] a_bucket Atomic pointer to the keys of the bucket.
+//! \param[in] a_keys Keys of the bucket to publish (may be null).
+//--------------------------------------------------------------
+template<class Policy, class Key, class... Args> inline
+void BasicKeyedDispatcher<Policy, Key, Args...>::Publish(std::atomic<Bucket*>& a_bucket,
+                                                         Bucket* a_keys)
+{
+    Bucket* previous = a_bucket.exchange(a_keys, Locking::PublishOrder);
+    if (previous)
+    {
+        m_retired.push_back(previous);
+    }
+    Locking::Reclaim(m_readers, m_retired, std::default_delete<Bucket>());
+}
+
+} // namespace Event
+} // namespace Simple
@@ -0,0 +1,286 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <simple/event/hazard_pointer.h>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Event
+{
+
+//--------------------------------------------------------------
+//! Mutex that does nothing, for objects only used by one thread.
+//--------------------------------------------------------------
+struct NullMutex
+{
+    void lock() {}
+    bool try_lock() { return true; }
+    void unlock() {}
+};
+
+//--------------------------------------------------------------
+//! Locking model (see DefaultPolicy) where writers (registering or
+//! removing listeners) lock a mutex, while readers (dispatching
+//! events) protect snapshots of listeners with hazard pointers, so
+//! they never lock a mutex or write to state shared with others.
+//! This is the locking model used unless a policy defines another.
+//--------------------------------------------------------------
+struct MutexLocking
+{
+    static constexpr bool Concurrent = true;
+    static constexpr std::memory_order PublishOrder = std::memory_order_seq_cst;
+
+    using Mutex = std::mutex;
+
+    struct Readers {};
+
+    class ReadGuard
+    {
+    public:
+        explicit ReadGuard(Readers&) {}
+
+        template<class Type>
+        Type* Protect(const std::atomic<Type*>& a_source);
+
+    private:
+        HazardPointer m_hazardPointer;
+    };
+
+    template<class Type, class Allocator, class Deleter>
+    static void Reclaim(Readers& a_readers,
+                        std::vector<Type*, Allocator>& a_retired,
+                        Deleter a_deleter);
+};
+
+//--------------------------------------------------------------
+//! Locking model where readers share a reader/writer lock, which
+//! is only taken exclusively to delete retired snapshots (without
+//! ever waiting for it, so writers never block on readers). Writers
+//! still lock a mutex among themselves. Readers need no hazard
+//! records, but all concurrent dispatches write to the same lock,
+//! and listeners must not dispatch with the dispatcher (or nest
+//! inside another dispatch of it) that invoked them.
+//--------------------------------------------------------------
+struct SharedMutexLocking
+{
+    static constexpr bool Concurrent = true;
+    static constexpr std::memory_order PublishOrder = std::memory_order_release;
+
+    using Mutex = std::mutex;
+
+    struct Readers
+    {
+        std::shared_mutex m_mutex;
+    };
+
+    class ReadGuard
+    {
+    public:
+        explicit ReadGuard(Readers& a_readers);
+
+        template<class Type>
+        Type* Protect(const std::atomic<Type*>& a_source);
+
+    private:
+        std::shared_lock<std::shared_mutex> m_lock;
+    };
+
+    template<class Type, class Allocator, class Deleter>
+    static void Reclaim(Readers& a_readers,
+                        std::vector<Type*, Allocator>& a_retired,
+                        Deleter a_deleter);
+};
+
+//--------------------------------------------------------------
+//! Locking model for objects that are only ever used by a single
+//! thread (at a time), which locks nothing and reads snapshots of
+//! listeners directly. Retired snapshots are deleted once the thread
+//! is no longer in the middle of dispatching an event, so listeners
+//! may still register and remove listeners while being invoked.
+//--------------------------------------------------------------
+struct NoLocking
+{
+    static constexpr bool Concurrent = false;
+    static constexpr std::memory_order PublishOrder = std::memory_order_relaxed;
+
+    using Mutex = NullMutex;
+
+    struct Readers {};
+
+    class ReadGuard
+    {
+    public:
+        explicit ReadGuard(Readers&);
+        ~ReadGuard();
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        template<class Type>
+        Type* Protect(const std::atomic<Type*>& a_source);
+    };
+
+    template<class Type, class Allocator, class Deleter>
+    static void Reclaim(Readers& a_readers,
+                        std::vector<Type*, Allocator>& a_retired,
+                        Deleter a_deleter);
+
+private:
+    static size_t& ReadDepth();
+};
+
+//--------------------------------------------------------------
+//! Loads a pointer and protects the object that it points to, so
+//! it will not be reclaimed until the guard is destroyed.
+//!
+//! \param[in] a_source Atomic pointer to an object to protect.
+//! \return Pointer to the protected object, which may be null.
+//--------------------------------------------------------------
+template<class Type> inline
+Type* MutexLocking::ReadGuard::Protect(const std::atomic<Type*>& a_source)
+{
+    return m_hazardPointer.Protect(a_source);
+}
+
+//--------------------------------------------------------------
+//! Deletes retired objects that no hazard pointer protects.
+//!
+//! \param[in] a_retired Objects retired by the writer.
+//! \param[in] a_deleter Function called to delete each object.
+//--------------------------------------------------------------
+template<class Type, class Allocator, class Deleter> inline
+void MutexLocking::Reclaim(Readers&,
+                           std::vector<Type*, Allocator>& a_retired,
+                           Deleter a_deleter)
+{
+    HazardPointer::Reclaim(a_retired, a_deleter);
+}
+
+//--------------------------------------------------------------
+//! Shares the lock with any other readers.
+//!
+//! \param[in] a_readers Lock shared by readers of the object.
+//--------------------------------------------------------------
+inline SharedMutexLocking::ReadGuard::ReadGuard(Readers& a_readers)
+    : m_lock(a_readers.m_mutex)
+{
+}
+
+//--------------------------------------------------------------
+//! Loads a pointer, whose object will not be reclaimed until the
+//! guard (which shares the lock) is destroyed.
+//!
+//! \param[in] a_source Atomic pointer to an object to protect.
+//! \return Pointer to the protected object, which may be null.
+//--------------------------------------------------------------
+template<class Type> inline
+Type* SharedMutexLocking::ReadGuard::Protect(const std::atomic<Type*>& a_source)
+{
+    return a_source.load(std::memory_order_acquire);
+}
+
+//--------------------------------------------------------------
+//! Deletes all retired objects if no reader holds the lock, else
+//! leaves them to be deleted by a later call.
+//!
+//! \param[in] a_readers Lock shared by readers of the object.
+//! \param[in] a_retired Objects retired by the writer.
+//! \param[in] a_deleter Function called to delete each object.
+//--------------------------------------------------------------
+template<class Type, class Allocator, class Deleter> inline
+void SharedMutexLocking::Reclaim(Readers& a_readers,
+                                 std::vector<Type*, Allocator>& a_retired,
+                                 Deleter a_deleter)
+{
+    if (a_retired.empty())
+    {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> lock(a_readers.m_mutex, std::try_to_lock);
+    if (lock.owns_lock())
+    {
+        for (Type* retired : a_retired)
+        {
+            a_deleter(retired);
+        }
+        a_retired.clear();
+    }
+}
+
+//--------------------------------------------------------------
+//! Enters a read, nested within any the thread is in the middle of.
+//--------------------------------------------------------------
+inline NoLocking::ReadGuard::ReadGuard(Readers&)
+{
+    ++ReadDepth();
+}
+
+//--------------------------------------------------------------
+//! Leaves the read.
+//--------------------------------------------------------------
+inline NoLocking::ReadGuard::~ReadGuard()
+{
+    --ReadDepth();
+}
+
+//--------------------------------------------------------------
+//! Loads a pointer, whose object will not be reclaimed until the
+//! thread has left all of the reads that it is in the middle of.
+//!
+//! \param[in] a_source Atomic pointer to an object to protect.
+//! \return Pointer to the protected object, which may be null.
+//--------------------------------------------------------------
+template<class Type> inline
+Type* NoLocking::ReadGuard::Protect(const std::atomic<Type*>& a_source)
+{
+    return a_source.load(std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+//! Deletes all retired objects if the thread is not in the middle
+//! of a read, else leaves them to be deleted by a later call.
+//!
+//! \param[in] a_retired Objects retired by the writer.
+//! \param[in] a_deleter Function called to delete each object.
+//--------------------------------------------------------------
+template<class Type, class Allocator, class Deleter> inline
+void NoLocking::Reclaim(Readers&,
+                        std::vector<Type*, Allocator>& a_retired,
+                        Deleter a_deleter)
+{
+    if (ReadDepth() == 0)
+    {
+        for (Type* retired : a_retired)
+        {
+            a_deleter(retired);
+        }
+        a_retired.clear();
+    }
+}
+
+//--------------------------------------------------------------
+//! Number of reads the calling thread is in the middle of.
+//!
+//! \return Reference to the read depth of the calling thread.
+//--------------------------------------------------------------
+inline size_t& NoLocking::ReadDepth()
+{
+    static thread_local size_t s_depth = 0;
+    return s_depth;
+}
+
+} // namespace Event
+} // namespace Simple
@@ -0,0 +1,250 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Event
+{
+
+//--------------------------------------------------------------
+//! Memory resource that pools fixed-size blocks, for the records
+//! that a dispatcher allocates (eg. listener entries and snapshots
+//! of listeners), so registering and removing listeners recycles
+//! memory rather than fragmenting the global heap.
+//!
+//! Blocks are sized in powers of two (from 64 bytes, so aligned to
+//! a cache line), and each size has its own list of free blocks.
+//! New blocks are carved from large chunks of memory taken from an
+//! upstream resource (eg. a std::pmr::monotonic_buffer_resource over
+//! a static buffer), which are only returned once the pool is gone,
+//! so memory use is bounded by the peak number of blocks in use.
+//! Larger (or more aligned) requests are passed to the upstream.
+//! Thread safe, as listeners may be released on any thread.
+//--------------------------------------------------------------
+class PoolResource : public std::pmr::memory_resource
+{
+public:
+    explicit PoolResource(size_t a_maxBlockSize = 4096,
+                          size_t a_chunkSize = 64 * 1024,
+                          std::pmr::memory_resource* a_upstream = std::pmr::get_default_resource());
+    ~PoolResource() override;
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    size_t MaxBlockSize() const;
+    size_t UpstreamBytes() const;
+
+private:
+    static constexpr size_t MinBlockSize = 64;
+    static constexpr size_t SizeCount = 15;
+
+    struct Block
+    {
+        Block* m_next;
+    };
+
+    struct alignas(MinBlockSize) Chunk
+    {
+        Chunk* m_next;
+        size_t m_size;
+    };
+
+    void* do_allocate(size_t a_bytes,
+                      size_t a_alignment) override;
+    void do_deallocate(void* a_block,
+                       size_t a_bytes,
+                       size_t a_alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& a_other) const noexcept override;
+
+    static size_t SizeIndex(size_t a_bytes);
+    bool Pooled(size_t a_bytes,
+                size_t a_alignment) const;
+
+    std::pmr::memory_resource* const m_upstream;
+    const size_t m_maxBlockSize;
+    const size_t m_chunkSize;
+    Block* m_freeBlocks[SizeCount] = {};
+    Chunk* m_chunks = nullptr;
+    char* m_unused = nullptr;
+    size_t m_unusedSize = 0;
+    size_t m_upstreamBytes = 0;
+    mutable std::mutex m_mutex;
+};
+
+//--------------------------------------------------------------
+//! Creates an empty pool, which takes no memory until first used.
+//!
+//! \param[in] a_maxBlockSize Largest request to pool (rounded up to
+//!            a power of two, from 64 bytes up to 1 MiB).
+//! \param[in] a_chunkSize Size of each chunk taken from the upstream.
+//! \param[in] a_upstream Resource that chunks are allocated from.
+//--------------------------------------------------------------
+inline PoolResource::PoolResource(size_t a_maxBlockSize,
+                                  size_t a_chunkSize,
+                                  std::pmr::memory_resource* a_upstream)
+    : m_upstream(a_upstream)
+    , m_maxBlockSize(MinBlockSize << SizeIndex(std::min(a_maxBlockSize,
+                                                        MinBlockSize << (SizeCount - 1))))
+    , m_chunkSize(a_chunkSize)
+{
+}
+
+//--------------------------------------------------------------
+//! Returns all chunks to the upstream resource, so all blocks must
+//! have been deallocated (or no longer be used) by this point.
+//--------------------------------------------------------------
+inline PoolResource::~PoolResource()
+{
+    while (m_chunks)
+    {
+        Chunk* chunk = m_chunks;
+        m_chunks = chunk->m_next;
+        m_upstream->deallocate(chunk, chunk->m_size, alignof(Chunk));
+    }
+}
+
+//--------------------------------------------------------------
+//! Largest request that is served by the pool, not the upstream.
+//!
+//! \return Size of the largest blocks in the pool.
+//--------------------------------------------------------------
+inline size_t PoolResource::MaxBlockSize() const
+{
+    return m_maxBlockSize;
+}
+
+//--------------------------------------------------------------
+//! Memory taken from the upstream resource for chunks of blocks
+//! (not including requests that were passed to the upstream).
+//!
+//! \return Number of bytes allocated from the upstream resource.
+//--------------------------------------------------------------
+inline size_t PoolResource::UpstreamBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_upstreamBytes;
+}
+
+//--------------------------------------------------------------
+//! Allocates a block, reusing a free block of the same size if
+//! there is one, else carving one from the current chunk (taking
+//! a new chunk from the upstream once it has been used up).
+//!
+//! \param[in] a_bytes Size of the memory to allocate.
+//! \param[in] a_alignment Alignment of the memory to allocate.
+//! \return Pointer to the allocated memory.
+//--------------------------------------------------------------
+inline void* PoolResource::do_allocate(size_t a_bytes,
+                                       size_t a_alignment)
+{
+    if (!Pooled(a_bytes, a_alignment))
+    {
+        return m_upstream->allocate(a_bytes, a_alignment);
+    }
+
+    const size_t sizeIndex = SizeIndex(a_bytes);
+    const size_t blockSize = MinBlockSize << sizeIndex;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (Block* block = m_freeBlocks[sizeIndex])
+    {
+        m_freeBlocks[sizeIndex] = block->m_next;
+        return block;
+    }
+    if (m_unusedSize < blockSize)
+    {
+        // The rest of the current chunk is left unused.
+        const size_t chunkSize = std::max(m_chunkSize, sizeof(Chunk) + blockSize);
+        Chunk* chunk = static_cast<Chunk*>(m_upstream->allocate(chunkSize, alignof(Chunk)));
+        chunk->m_next = m_chunks;
+        chunk->m_size = chunkSize;
+        m_chunks = chunk;
+        m_unused = reinterpret_cast<char*>(chunk) + sizeof(Chunk);
+        m_unusedSize = (chunkSize - sizeof(Chunk)) / MinBlockSize * MinBlockSize;
+        m_upstreamBytes += chunkSize;
+    }
+    void* block = m_unused;
+    m_unused += blockSize;
+    m_unusedSize -= blockSize;
+    return block;
+}
+
+//--------------------------------------------------------------
+//! Deallocates a block, adding it to the free blocks of its size.
+//!
+//! \param[in] a_block Pointer to the memory to deallocate.
+//! \param[in] a_bytes Size the memory was allocated with.
+//! \param[in] a_alignment Alignment the memory was allocated with.
+//--------------------------------------------------------------
+inline void PoolResource::do_deallocate(void* a_block,
+                                        size_t a_bytes,
+                                        size_t a_alignment)
+{
+    if (!Pooled(a_bytes, a_alignment))
+    {
+        m_upstream->deallocate(a_block, a_bytes, a_alignment);
+        return;
+    }
+
+    const size_t sizeIndex = SizeIndex(a_bytes);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Block* block = static_cast<Block*>(a_block);
+    block->m_next = m_freeBlocks[sizeIndex];
+    m_freeBlocks[sizeIndex] = block;
+}
+
+//--------------------------------------------------------------
+//! Memory from a pool can only be deallocated by the same pool.
+//!
+//! \param[in] a_other Resource to compare with.
+//! \return True if the other resource is this pool.
+//--------------------------------------------------------------
+inline bool PoolResource::do_is_equal(const std::pmr::memory_resource& a_other) const noexcept
+{
+    return this == &a_other;
+}
+
+//--------------------------------------------------------------
+//! Index of the smallest block size that can hold a request.
+//!
+//! \param[in] a_bytes Size of the memory requested.
+//! \return Index of the block size (0 for 64 bytes, 1 for 128...).
+//--------------------------------------------------------------
+inline size_t PoolResource::SizeIndex(size_t a_bytes)
+{
+    size_t sizeIndex = 0;
+    while ((MinBlockSize << sizeIndex) < a_bytes)
+    {
+        ++sizeIndex;
+    }
+    return sizeIndex;
+}
+
+//--------------------------------------------------------------
+//! Whether a request is served by the pool or the upstream.
+//!
+//! \param[in] a_bytes Size of the memory requested.
+//! \param[in] a_alignment Alignment of the memory requested.
+//! \return True if the request is served from the pool.
+//--------------------------------------------------------------
+inline bool PoolResource::Pooled(size_t a_bytes,
+                                 size_t a_alignment) const
+{
+    return a_bytes <= m_maxBlockSize && a_alignment <= MinBlockSize;
+}
+
+} // namespace Event
+} // namespace Simple
@@ -0,0 +1,322 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <simple/event/dispatcher.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Event
+{
+
+//--------------------------------------------------------------
+//! Template class that spreads its listeners over a number of
+//! shards (each a Dispatcher with its own mutex and snapshot), so
+//! many threads can register and remove listeners at once without
+//! all contending over one mutex, or copying every listener each
+//! time that one is registered (only those of its shard are).
+//!
+//! Each thread registers with one shard (threads are assigned a
+//! shard in turn), and dispatching merges the snapshots of every
+//! shard by sort index, then by the order that listeners were
+//! registered, so listeners are invoked in exactly the same order
+//! as by a single Dispatcher, and dispatching ends once a listener
+//! consumes the event. Merging costs more than walking one array,
+//! so only use this for dispatchers with heavy registration churn.
+//!
+//! \tparam Policy Class that defines how callables are stored.
+//! \tparam Args Parameter pack that defines the event signature.
+//--------------------------------------------------------------
+template<class Policy, class... Args>
+class BasicShardedDispatcher
+{
+public:
+    using Dispatcher = BasicDispatcher<Policy, Args...>;
+    using Callable = typename Dispatcher::Callable;
+    using Connection = typename Dispatcher::Connection;
+    using Listener = typename Dispatcher::Listener;
+    using Filter = typename Dispatcher::Filter;
+
+    static constexpr size_t MaxShardCount = 64;
+
+    explicit BasicShardedDispatcher(size_t a_shardCount = 16,
+                                    std::pmr::memory_resource* a_resource = std::pmr::get_default_resource());
+
+    BasicShardedDispatcher(const BasicShardedDispatcher&) = delete;
+    BasicShardedDispatcher& operator=(const BasicShardedDispatcher&) = delete;
+
+    [[nodiscard]]
+    Listener Register(Callable a_callable,
+                      const int32_t& a_sortIndex = 0);
+    bool Remove(const Listener& a_listener);
+
+    [[nodiscard]]
+    Connection Connect(Callable a_callable,
+                       const int32_t& a_sortIndex = 0);
+    bool Remove(const Connection& a_connection);
+
+    void Dispatch(const Args&... a_args);
+    size_t Compact();
+    size_t ShardCount() const;
+
+private:
+    using Entry = typename Dispatcher::Entry;
+    using Snapshot = typename Dispatcher::Snapshot;
+    using Locking = typename Dispatcher::Locking;
+
+    struct Cursor
+    {
+        Entry* const* m_next;
+        Entry* const* m_end;
+    };
+
+    static bool Before(const Entry& a_entry,
+                       const Entry& a_other);
+    static size_t ThreadIndex();
+    Dispatcher& ThreadShard();
+
+    std::vector<std::unique_ptr<Dispatcher>> m_shards;
+};
+
+//--------------------------------------------------------------
+//! Sharded dispatcher that stores callables using the default policy.
+//!
+//! \tparam Args Parameter pack that defines the event signature.
+//--------------------------------------------------------------
+template<class... Args>
+using ShardedDispatcher = BasicShardedDispatcher<DefaultPolicy, Args...>;
+
+//--------------------------------------------------------------
+//! Creates the shards.
+//!
+//! \param[in] a_shardCount Number of shards (from 1 to MaxShardCount),
+//!            eg. the number of threads that register listeners.
+//! \param[in] a_resource Memory resource the shards allocate from.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicShardedDispatcher<Policy, Args...>::BasicShardedDispatcher(size_t a_shardCount,
+                                                                std::pmr::memory_resource* a_resource)
+{
+    const size_t shardCount = std::clamp<size_t>(a_shardCount, 1, MaxShardCount);
+    m_shards.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; ++i)
+    {
+        m_shards.push_back(std::make_unique<Dispatcher>(a_resource));
+    }
+}
+
+//--------------------------------------------------------------
+//! Registers a callable (with the shard of the calling thread) to
+//! invoke when each event is dispatched.
+//!
+//! \param[in] a_callable A callable object that will be invoked.
+//! \param[in] a_sortIndex Order in which to invoke the callable.
+//! \return Listener to retain while callable should be invoked.
+//!         Release all references to 'deregister' the callable.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+typename BasicShardedDispatcher<Policy, Args...>::Listener
+BasicShardedDispatcher<Policy, Args...>::Register(Callable a_callable,
+                                                  const int32_t& a_sortIndex)
+{
+    return ThreadShard().Register(std::move(a_callable), a_sortIndex);
+}
+
+//--------------------------------------------------------------
+//! Remove a listener so not invoked when events are dispatched.
+//!
+//! \param[in] a_listener Listener object to stop being invoked.
+//! \return True if the listener was removed or false otherwise.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+bool BasicShardedDispatcher<Policy, Args...>::Remove(const Listener& a_listener)
+{
+    return std::any_of(m_shards.begin(), m_shards.end(),
+                       [&a_listener](const std::unique_ptr<Dispatcher>& a_shard)
+    {
+        return a_shard->Remove(a_listener);
+    });
+}
+
+//--------------------------------------------------------------
+//! Registers a callable (with the shard of the calling thread) to
+//! invoke when each event is dispatched.
+//!
+//! \param[in] a_callable A callable object that will be invoked.
+//! \param[in] a_sortIndex Order in which to invoke the callable.
+//! \return Connection to retain while callable should be invoked.
+//!         Destroy or disconnect it to 'deregister' the callable.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+typename BasicShardedDispatcher<Policy, Args...>::Connection
+BasicShardedDispatcher<Policy, Args...>::Connect(Callable a_callable,
+                                                 const int32_t& a_sortIndex)
+{
+    return ThreadShard().Connect(std::move(a_callable), a_sortIndex);
+}
+
+//--------------------------------------------------------------
+//! Remove a connection so not invoked when events are dispatched.
+//! Each shard checks whether the connection was made with it (in
+//! constant time, without locking), so only its own shard locks.
+//!
+//! \param[in] a_connection Connection object to stop being invoked.
+//! \return True if the connection was removed or false otherwise.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+bool BasicShardedDispatcher<Policy, Args...>::Remove(const Connection& a_connection)
+{
+    return std::any_of(m_shards.begin(), m_shards.end(),
+                       [&a_connection](const std::unique_ptr<Dispatcher>& a_shard)
+    {
+        return a_shard->Remove(a_connection);
+    });
+}
+
+//--------------------------------------------------------------
+//! Sequentially dispatches an event to the listeners of all shards,
+//! merged by sort index then by the order they were registered.
+//! If a listener returns Status::Consumed the dispatch will end,
+//! and no remaining (lower priority) listeners shall be invoked.
+//!
+//! \param[in] a_args Arguments passed by reference to listeners.
+//! \throw DispatchDepthExceeded if nested deeper than the limit.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicShardedDispatcher<Policy, Args...>::Dispatch(const Args&... a_args)
+{
+    const DispatchDepth depth;
+
+    // Grab the snapshot of each shard that has any listeners.
+    const uint64_t epoch = Dispatcher::ExpiryEpoch().load(std::memory_order_acquire);
+    std::optional<typename Locking::ReadGuard> readGuards[MaxShardCount];
+    Cursor cursors[MaxShardCount];
+    size_t cursorCount = 0;
+    for (const std::unique_ptr<Dispatcher>& shard : m_shards)
+    {
+        if (!shard->m_listeners.load(std::memory_order_relaxed))
+        {
+            continue;
+        }
+        typename Locking::ReadGuard& readGuard = readGuards[cursorCount].emplace(shard->m_readers);
+        const Snapshot* snapshot = readGuard.Protect(shard->m_listeners);
+        if (snapshot && !snapshot->m_entries.empty())
+        {
+            const std::pmr::vector<Entry*>& entries = snapshot->m_entries;
+            cursors[cursorCount++] = { entries.data(), entries.data() + entries.size() };
+        }
+    }
+
+    // Repeatedly invoke the first listener of all the shards.
+    while (cursorCount > 0)
+    {
+        size_t first = 0;
+        for (size_t i = 1; i < cursorCount; ++i)
+        {
+            if (Before(**cursors[i].m_next, **cursors[first].m_next))
+            {
+                first = i;
+            }
+        }
+        const Entry* entry = *cursors[first].m_next++;
+        if (cursors[first].m_next == cursors[first].m_end)
+        {
+            cursors[first] = cursors[--cursorCount];
+        }
+        if (entry->Expired(epoch) || !entry->m_callable)
+        {
+            continue;
+        }
+        if (Dispatcher::Call(*entry, a_args...) == Status::Consumed)
+        {
+            // Stop sending the event.
+            break;
+        }
+    }
+}
+
+//--------------------------------------------------------------
+//! Prunes all expired listeners from every shard now (see
+//! Dispatcher::Compact). Must not be called by listeners.
+//!
+//! \return Number of expired listeners that were pruned.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+size_t BasicShardedDispatcher<Policy, Args...>::Compact()
+{
+    size_t pruned = 0;
+    for (const std::unique_ptr<Dispatcher>& shard : m_shards)
+    {
+        pruned += shard->Compact();
+    }
+    return pruned;
+}
+
+//--------------------------------------------------------------
+//! Number of shards that listeners are spread over.
+//!
+//! \return Number of shards.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+size_t BasicShardedDispatcher<Policy, Args...>::ShardCount() const
+{
+    return m_shards.size();
+}
+
+//--------------------------------------------------------------
+//! Whether an entry is invoked before another, which is decided by
+//! sort index, then by the order that they were registered.
+//!
+//! \param[in] a_entry Entry to compare.
+//! \param[in] a_other Entry to compare with.
+//! \return True if the entry is invoked before the other.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+bool BasicShardedDispatcher<Policy, Args...>::Before(const Entry& a_entry,
+                                                     const Entry& a_other)
+{
+    return a_entry.m_sortIndex != a_other.m_sortIndex ? a_entry.m_sortIndex < a_other.m_sortIndex :
+                                                        a_entry.m_sequence < a_other.m_sequence;
+}
+
+//--------------------------------------------------------------
+//! Index of the calling thread, which is assigned to each thread
+//! in turn when first used (so threads are spread over shards).
+//!
+//! \return Index of the calling thread.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+size_t BasicShardedDispatcher<Policy, Args...>::ThreadIndex()
+{
+    static std::atomic<size_t> s_nextIndex = { 0 };
+    static thread_local const size_t s_index = s_nextIndex.fetch_add(1, std::memory_order_relaxed);
+    return s_index;
+}
+
+//--------------------------------------------------------------
+//! Shard that the calling thread registers listeners with.
+//!
+//! \return Reference to the shard of the calling thread.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+typename BasicShardedDispatcher<Policy, Args...>::Dispatcher&
+BasicShardedDispatcher<Policy, Args...>::ThreadShard()
+{
+    return *m_shards[ThreadIndex() % m_shards.size()];
+}
+
+} // namespace Event
+} // namespace Simple
@@ -0,0 +1,141 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <simple/event/dispatcher.h>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Event
+{
+
+//--------------------------------------------------------------
+//! Listener of a StaticDispatcher, which is a function known at
+//! compile time (eg. a free function or static member function)
+//! along with the order in which to invoke it.
+//!
+//! \tparam Function Function to invoke when an event is dispatched.
+//! \tparam SortIndex Order in which to invoke the function.
+//--------------------------------------------------------------
+template<auto Function, int32_t SortIndex = 0>
+struct StaticListener
+{
+    static constexpr int32_t s_sortIndex = SortIndex;
+
+    //----------------------------------------------------------
+    //! Invokes the function.
+    //!
+    //! \param[in] a_args Arguments passed by reference to function.
+    //! \return Status returned by the function.
+    //----------------------------------------------------------
+    template<class... Args>
+    static Status Invoke(const Args&... a_args)
+    {
+        return Function(a_args...);
+    }
+};
+
+//--------------------------------------------------------------
+//! Template class that dispatches events to a set of listeners
+//! which is fixed at compile time, for event paths that are wired
+//! once and never change. Listeners are sorted by their sort index
+//! at compile time (keeping listeners with the same index in the
+//! order they are listed), and follow the same Status semantics as
+//! Dispatcher: dispatching ends once a listener consumes the event.
+//!
+//! The whole chain of listeners is a single fold expression over
+//! function pointers known at compile time, so the compiler is free
+//! to inline it: there is no type erasure, heap allocation, mutex,
+//! or reference counting involved in dispatching an event.
+//!
+//! \tparam Listeners StaticListener types to invoke, in any order.
+//--------------------------------------------------------------
+template<class... Listeners>
+class StaticDispatcher
+{
+public:
+    template<class... Args>
+    static void Dispatch(const Args&... a_args);
+
+private:
+    static constexpr size_t s_count = sizeof...(Listeners);
+    static constexpr std::array<size_t, s_count> Order();
+    static constexpr std::array<size_t, s_count> s_order = Order();
+
+    template<size_t Index>
+    using Listener = typename std::tuple_element<s_order[Index], std::tuple<Listeners...>>::type;
+
+    template<size_t... Indices, class... Args>
+    static void Dispatch(std::index_sequence<Indices...>,
+                         const Args&... a_args);
+};
+
+//--------------------------------------------------------------
+//! Sequentially dispatches an event to all listeners. If a listener
+//! returns Status::Consumed the dispatch will end, and no remaining
+//! (lower priority) listeners shall be invoked.
+//!
+//! \param[in] a_args Arguments passed by reference to listeners.
+//--------------------------------------------------------------
+template<class... Listeners>
+template<class... Args> inline
+void StaticDispatcher<Listeners...>::Dispatch(const Args&... a_args)
+{
+    Dispatch(std::make_index_sequence<s_count>(), a_args...);
+}
+
+//--------------------------------------------------------------
+//! Invokes each listener in sorted order, until one consumes the
+//! event (the logical or fold stops at the first that returns true).
+//!
+//! \param[in] a_args Arguments passed by reference to listeners.
+//--------------------------------------------------------------
+template<class... Listeners>
+template<size_t... Indices, class... Args> inline
+void StaticDispatcher<Listeners...>::Dispatch(std::index_sequence<Indices...>,
+                                              const Args&... a_args)
+{
+    (void)(... || (Listener<Indices>::Invoke(a_args...) == Status::Consumed));
+}
+
+//--------------------------------------------------------------
+//! Sorts the listeners by their sort index (with a stable sort, so
+//! listeners sharing an index stay in the order they are listed).
+//!
+//! \return Index of each listener in the pack, in priority order.
+//--------------------------------------------------------------
+template<class... Listeners>
+constexpr std::array<size_t, StaticDispatcher<Listeners...>::s_count>
+StaticDispatcher<Listeners...>::Order()
+{
+    const std::array<int32_t, s_count> sortIndices = { Listeners::s_sortIndex... };
+    std::array<size_t, s_count> order = {};
+    for (size_t i = 0; i < s_count; ++i)
+    {
+        order[i] = i;
+    }
+    for (size_t i = 1; i < s_count; ++i)
+    {
+        for (size_t j = i; j > 0 && sortIndices[order[j - 1]] > sortIndices[order[j]]; --j)
+        {
+            const size_t previous = order[j - 1];
+            order[j - 1] = order[j];
+            order[j] = previous;
+        }
+    }
+    return order;
+}
+
+} // namespace Event
+} // namespace Simple
@@ -0,0 +1,113 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Event
+{
+
+//--------------------------------------------------------------
+//! Statistics recorded for a listener by an instrumented dispatcher
+//! (see InstrumentedPolicy), covering every time it was invoked.
+//--------------------------------------------------------------
+struct ListenerStatistics
+{
+    int32_t m_sortIndex = 0; //!< Sort index the listener was registered with.
+    uint64_t m_invocations = 0; //!< Number of times it was invoked.
+    uint64_t m_continued = 0; //!< Number of times it returned Status::Continue.
+    uint64_t m_consumed = 0; //!< Number of times it returned Status::Consumed.
+    uint64_t m_filtered = 0; //!< Number of times it returned Status::Filtered.
+    std::chrono::nanoseconds m_totalTime = {}; //!< Cumulative time spent invoking it.
+    std::chrono::nanoseconds m_maxTime = {}; //!< Longest time spent invoking it once.
+};
+
+//--------------------------------------------------------------
+//! Statistics recorded by an instrumented dispatcher as a whole.
+//--------------------------------------------------------------
+struct DispatcherStatistics
+{
+    uint64_t m_dispatches = 0; //!< Number of events dispatched (by any means).
+    uint64_t m_prunedListeners = 0; //!< Number of expired listeners pruned.
+    std::chrono::nanoseconds m_lockWaitTime = {}; //!< Time spent waiting on mutexes.
+};
+
+//--------------------------------------------------------------
+//! Counter that many threads can add to without contending over
+//! a single cache line, by spreading the count over a number of
+//! cache line aligned stripes (each thread adds to one of them).
+//--------------------------------------------------------------
+class StripedCounter
+{
+public:
+    void Add(uint64_t a_value);
+    uint64_t Load() const;
+
+private:
+    static constexpr size_t StripeCount = 16;
+
+    struct alignas(64) Stripe
+    {
+        std::atomic<uint64_t> m_value = { 0 };
+    };
+
+    static size_t ThreadStripe();
+
+    Stripe m_stripes[StripeCount];
+};
+
+//--------------------------------------------------------------
+//! Adds a value to the stripe used by the calling thread.
+//!
+//! \param[in] a_value Value to add to the counter.
+//--------------------------------------------------------------
+inline void StripedCounter::Add(uint64_t a_value)
+{
+    m_stripes[ThreadStripe()].m_value.fetch_add(a_value, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+//! Sums the values added by all threads (concurrent additions may
+//! or may not be included).
+//!
+//! \return Total of all values added to the counter.
+//--------------------------------------------------------------
+inline uint64_t StripedCounter::Load() const
+{
+    uint64_t total = 0;
+    for (const Stripe& stripe : m_stripes)
+    {
+        total += stripe.m_value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+//--------------------------------------------------------------
+//! Stripe used by the calling thread, which is assigned to each
+//! thread in turn when first used (so up to StripeCount threads
+//! never share a stripe).
+//!
+//! \return Index of the stripe used by the calling thread.
+//--------------------------------------------------------------
+inline size_t StripedCounter::ThreadStripe()
+{
+    static std::atomic<size_t> s_nextStripe = { 0 };
+    static thread_local const size_t s_stripe = s_nextStripe.fetch_add(1, std::memory_order_relaxed) %
+                                                StripeCount;
+    return s_stripe;
+}
+
+} // namespace Event
+} // namespace Simple
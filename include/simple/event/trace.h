@@ -0,0 +1,596 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <simple/event/dispatcher.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Event
+{
+
+//--------------------------------------------------------------
+//! Pace at which a Replayer dispatches the events of a trace.
+//--------------------------------------------------------------
+enum class ReplaySpeed
+{
+    Original = 0, //!< Wait so events are as far apart as recorded.
+    Fastest = 1 //!< Dispatch each event as soon as the last ends.
+};
+
+//--------------------------------------------------------------
+//! Exception thrown when a trace file cannot be opened, written
+//! or read, or its contents do not match the event signature.
+//--------------------------------------------------------------
+class TraceError : public std::runtime_error
+{
+public:
+    explicit TraceError(const std::string& a_message);
+};
+
+//--------------------------------------------------------------
+//! What happened to an event when it was recorded in a trace.
+//--------------------------------------------------------------
+struct TraceRecord
+{
+    std::chrono::nanoseconds m_time = {}; //!< Time since recording started.
+    uint32_t m_invoked = 0; //!< Number of listeners invoked.
+    bool m_consumed = false; //!< Whether a listener consumed it.
+    int32_t m_consumerSortIndex = 0; //!< Sort index of the listener that did.
+};
+
+//--------------------------------------------------------------
+//! Template struct that writes event arguments to a trace (and
+//! reads them back), by copying the bytes of trivially copyable
+//! types. Specialize it for any other type of event argument.
+//!
+//! \tparam Type Type of the event argument.
+//--------------------------------------------------------------
+template<class Type>
+struct TraceSerializer
+{
+    static_assert(std::is_trivially_copyable<Type>::value,
+                  "Specialize TraceSerializer for arguments that are not trivially copyable");
+
+    static void Write(std::vector<char>& a_buffer,
+                      const Type& a_value);
+    static Type Read(const char*& a_data,
+                     const char* a_end);
+};
+
+//--------------------------------------------------------------
+//! Writes (and reads) strings as their length then characters.
+//--------------------------------------------------------------
+template<>
+struct TraceSerializer<std::string>
+{
+    static void Write(std::vector<char>& a_buffer,
+                      const std::string& a_value);
+    static std::string Read(const char*& a_data,
+                            const char* a_end);
+};
+
+template<class Policy, class... Args>
+class BasicReplayer;
+
+//--------------------------------------------------------------
+//! Template class that dispatches events with a Dispatcher (just
+//! as its Dispatch function would), and captures each of them to
+//! a compact binary trace file, along with when it was dispatched,
+//! how many listeners were invoked, and which one consumed it, so
+//! that a Replayer can push the same events through a dispatcher
+//! again later (eg. to profile it, or compare it with a change).
+//!
+//! Records are appended to a buffer that is written to the file
+//! in large blocks, so dispatching only copies the arguments of
+//! each event (while holding a mutex, so many threads may record
+//! at once). Events that are dispatched by other means (or with
+//! the dispatcher directly) are not recorded. Traces are written
+//! in native byte order, so read them on the same platform.
+//!
+//! \tparam Policy Class that defines how callables are stored.
+//! \tparam Args Parameter pack that defines the event signature.
+//--------------------------------------------------------------
+template<class Policy, class... Args>
+class BasicRecorder
+{
+public:
+    using Dispatcher = BasicDispatcher<Policy, Args...>;
+
+    BasicRecorder(Dispatcher& a_dispatcher,
+                  const std::string& a_path,
+                  size_t a_bufferSize = 64 * 1024);
+    ~BasicRecorder();
+
+    BasicRecorder(const BasicRecorder&) = delete;
+    BasicRecorder& operator=(const BasicRecorder&) = delete;
+
+    void Dispatch(const Args&... a_args);
+    void Flush();
+    size_t Size() const;
+
+private:
+    template<class OtherPolicy, class... OtherArgs>
+    friend class BasicReplayer;
+
+    static constexpr char Magic[8] = { 'S', 'E', 'V', 'T', 'R', 'A', 'C', 'E' };
+    static constexpr uint32_t Version = 1;
+    static constexpr size_t RecordHeaderSize = 25;
+
+    static TraceRecord Deliver(Dispatcher& a_dispatcher,
+                               const Args&... a_args);
+    void Write();
+
+    Dispatcher& m_dispatcher;
+    std::FILE* m_file;
+    std::vector<char> m_buffer;
+    const size_t m_bufferSize;
+    const std::chrono::steady_clock::time_point m_start;
+    mutable std::mutex m_mutex;
+    size_t m_size = 0;
+};
+
+//--------------------------------------------------------------
+//! Recorder that dispatches with the default policy.
+//!
+//! \tparam Args Parameter pack that defines the event signature.
+//--------------------------------------------------------------
+template<class... Args>
+using Recorder = BasicRecorder<DefaultPolicy, Args...>;
+
+//--------------------------------------------------------------
+//! Template class that reads a trace file (written by a Recorder
+//! with the same event signature) into memory, then dispatches its
+//! events again with any dispatcher, either as fast as possible or
+//! as far apart as they were recorded. Replaying reports how many
+//! events had a different outcome than when they were recorded.
+//!
+//! \tparam Policy Class that defines how callables are stored.
+//! \tparam Args Parameter pack that defines the event signature.
+//--------------------------------------------------------------
+template<class Policy, class... Args>
+class BasicReplayer
+{
+public:
+    using Dispatcher = BasicDispatcher<Policy, Args...>;
+
+    explicit BasicReplayer(const std::string& a_path);
+
+    size_t Replay(Dispatcher& a_dispatcher,
+                  ReplaySpeed a_speed = ReplaySpeed::Fastest) const;
+    const std::vector<TraceRecord>& Records() const;
+    size_t Size() const;
+
+private:
+    using Recorder = BasicRecorder<Policy, Args...>;
+
+    struct Payload
+    {
+        size_t m_offset;
+        size_t m_size;
+    };
+
+    std::vector<char> m_data;
+    std::vector<TraceRecord> m_records;
+    std::vector<Payload> m_payloads;
+};
+
+//--------------------------------------------------------------
+//! Replayer that dispatches with the default policy.
+//!
+//! \tparam Args Parameter pack that defines the event signature.
+//--------------------------------------------------------------
+template<class... Args>
+using Replayer = BasicReplayer<DefaultPolicy, Args...>;
+
+//--------------------------------------------------------------
+//! Creates the exception.
+//!
+//! \param[in] a_message Description of what went wrong.
+//--------------------------------------------------------------
+inline TraceError::TraceError(const std::string& a_message)
+    : std::runtime_error(a_message)
+{
+}
+
+//--------------------------------------------------------------
+//! Appends the bytes of a value to a buffer.
+//!
+//! \param[in] a_buffer Buffer to append to.
+//! \param[in] a_value Value to write.
+//--------------------------------------------------------------
+template<class Type> inline
+void TraceSerializer<Type>::Write(std::vector<char>& a_buffer,
+                                  const Type& a_value)
+{
+    const char* bytes = reinterpret_cast<const char*>(&a_value);
+    a_buffer.insert(a_buffer.end(), bytes, bytes + sizeof(Type));
+}
+
+//--------------------------------------------------------------
+//! Copies the bytes of a value out of a buffer.
+//!
+//! \param[in] a_data Position to read from, which is advanced.
+//! \param[in] a_end End of the data that may be read.
+//! \return Value that was read.
+//! \throw TraceError if there are not enough bytes left to read.
+//--------------------------------------------------------------
+template<class Type> inline
+Type TraceSerializer<Type>::Read(const char*& a_data,
+                                 const char* a_end)
+{
+    if (static_cast<size_t>(a_end - a_data) < sizeof(Type))
+    {
+        throw TraceError("Trace record is truncated");
+    }
+    Type value;
+    std::memcpy(&value, a_data, sizeof(Type));
+    a_data += sizeof(Type);
+    return value;
+}
+
+//--------------------------------------------------------------
+//! Appends the length then the characters of a string to a buffer.
+//!
+//! \param[in] a_buffer Buffer to append to.
+//! \param[in] a_value String to write.
+//--------------------------------------------------------------
+inline void TraceSerializer<std::string>::Write(std::vector<char>& a_buffer,
+                                                const std::string& a_value)
+{
+    TraceSerializer<uint64_t>::Write(a_buffer, a_value.size());
+    a_buffer.insert(a_buffer.end(), a_value.begin(), a_value.end());
+}
+
+//--------------------------------------------------------------
+//! Reads the length then the characters of a string from a buffer.
+//!
+//! \param[in] a_data Position to read from, which is advanced.
+//! \param[in] a_end End of the data that may be read.
+//! \return String that was read.
+//! \throw TraceError if there are not enough bytes left to read.
+//--------------------------------------------------------------
+inline std::string TraceSerializer<std::string>::Read(const char*& a_data,
+                                                      const char* a_end)
+{
+    const uint64_t size = TraceSerializer<uint64_t>::Read(a_data, a_end);
+    if (static_cast<uint64_t>(a_end - a_data) < size)
+    {
+        throw TraceError("Trace record is truncated");
+    }
+    std::string value(a_data, static_cast<size_t>(size));
+    a_data += size;
+    return value;
+}
+
+//--------------------------------------------------------------
+//! Creates (or truncates) a trace file and writes its header.
+//!
+//! \param[in] a_dispatcher Dispatcher to dispatch events with.
+//! \param[in] a_path Path of the trace file to write.
+//! \param[in] a_bufferSize Bytes to buffer before writing to file.
+//! \throw TraceError if the file could not be opened or written.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicRecorder<Policy, Args...>::BasicRecorder(Dispatcher& a_dispatcher,
+                                              const std::string& a_path,
+                                              size_t a_bufferSize)
+    : m_dispatcher(a_dispatcher)
+    , m_file(std::fopen(a_path.c_str(), "wb"))
+    , m_bufferSize(a_bufferSize)
+    , m_start(std::chrono::steady_clock::now())
+{
+    if (!m_file)
+    {
+        throw TraceError("Could not open trace file " + a_path);
+    }
+    m_buffer.reserve(m_bufferSize + RecordHeaderSize);
+    m_buffer.insert(m_buffer.end(), Magic, Magic + sizeof(Magic));
+    TraceSerializer<uint32_t>::Write(m_buffer, Version);
+    TraceSerializer<uint32_t>::Write(m_buffer, static_cast<uint32_t>(sizeof...(Args)));
+    try
+    {
+        Write();
+    }
+    catch (...)
+    {
+        std::fclose(m_file);
+        throw;
+    }
+}
+
+//--------------------------------------------------------------
+//! Writes any buffered records and closes the trace file (errors
+//! are ignored, so call Flush first to find out about them).
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicRecorder<Policy, Args...>::~BasicRecorder()
+{
+    if (!m_buffer.empty())
+    {
+        std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+    }
+    std::fclose(m_file);
+}
+
+//--------------------------------------------------------------
+//! Sequentially dispatches an event to registered listeners (see
+//! Dispatcher::Dispatch), then records it in the trace.
+//!
+//! \param[in] a_args Arguments passed by reference to listeners.
+//! \throw DispatchDepthExceeded if nested deeper than the limit.
+//! \throw TraceError if the buffered records could not be written.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicRecorder<Policy, Args...>::Dispatch(const Args&... a_args)
+{
+    const auto start = std::chrono::steady_clock::now();
+    TraceRecord record = Deliver(m_dispatcher, a_args...);
+    record.m_time = std::chrono::duration_cast<std::chrono::nanoseconds>(start - m_start);
+
+    // Append the record, with the size of its payload once known.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    TraceSerializer<int64_t>::Write(m_buffer, static_cast<int64_t>(record.m_time.count()));
+    TraceSerializer<uint32_t>::Write(m_buffer, record.m_invoked);
+    TraceSerializer<uint8_t>::Write(m_buffer, record.m_consumed ? 1 : 0);
+    TraceSerializer<int32_t>::Write(m_buffer, record.m_consumerSortIndex);
+    const size_t sizeOffset = m_buffer.size();
+    TraceSerializer<uint64_t>::Write(m_buffer, 0);
+    (TraceSerializer<typename std::decay<Args>::type>::Write(m_buffer, a_args), ...);
+    const uint64_t payloadSize = m_buffer.size() - sizeOffset - sizeof(uint64_t);
+    std::memcpy(m_buffer.data() + sizeOffset, &payloadSize, sizeof(payloadSize));
+    ++m_size;
+
+    if (m_buffer.size() >= m_bufferSize)
+    {
+        Write();
+    }
+}
+
+//--------------------------------------------------------------
+//! Writes any buffered records to the trace file.
+//!
+//! \throw TraceError if the buffered records could not be written.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicRecorder<Policy, Args...>::Flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Write();
+    if (std::fflush(m_file) != 0)
+    {
+        throw TraceError("Could not write trace file");
+    }
+}
+
+//--------------------------------------------------------------
+//! Number of events that have been recorded.
+//!
+//! \return Number of events recorded.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+size_t BasicRecorder<Policy, Args...>::Size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+//--------------------------------------------------------------
+//! Sequentially dispatches an event to the listeners of a dispatcher
+//! (exactly as Dispatch would), noting which listeners it reached.
+//!
+//! \param[in] a_dispatcher Dispatcher to dispatch the event with.
+//! \param[in] a_args Arguments passed by reference to listeners.
+//! \return What happened to the event (with no time set).
+//! \throw DispatchDepthExceeded if nested deeper than the limit.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+TraceRecord BasicRecorder<Policy, Args...>::Deliver(Dispatcher& a_dispatcher,
+                                                    const Args&... a_args)
+{
+    const DispatchDepth depth;
+
+    TraceRecord record;
+    const uint64_t epoch = Dispatcher::ExpiryEpoch().load(std::memory_order_acquire);
+    typename Dispatcher::Locking::ReadGuard readGuard(a_dispatcher.m_readers);
+    const typename Dispatcher::Snapshot* snapshot = readGuard.Protect(a_dispatcher.m_listeners);
+    if (snapshot)
+    {
+        for (const typename Dispatcher::Entry* entry : snapshot->m_entries)
+        {
+            if (entry->Expired(epoch) || !entry->m_callable)
+            {
+                continue;
+            }
+            ++record.m_invoked;
+            if (Dispatcher::Call(*entry, a_args...) == Status::Consumed)
+            {
+                // Stop sending the event.
+                record.m_consumed = true;
+                record.m_consumerSortIndex = entry->m_sortIndex;
+                break;
+            }
+        }
+    }
+    a_dispatcher.CountDispatches(1);
+    return record;
+}
+
+//--------------------------------------------------------------
+//! Writes and clears the buffered records (with the mutex locked).
+//!
+//! \throw TraceError if the buffered records could not be written.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+void BasicRecorder<Policy, Args...>::Write()
+{
+    const size_t written = std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+    const bool failed = written != m_buffer.size();
+    m_buffer.clear();
+    if (failed)
+    {
+        throw TraceError("Could not write trace file");
+    }
+}
+
+//--------------------------------------------------------------
+//! Reads a trace file into memory, and indexes its records.
+//!
+//! \param[in] a_path Path of the trace file to read.
+//! \throw TraceError if the file could not be read, or was not
+//!        recorded with the same number of event arguments.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+BasicReplayer<Policy, Args...>::BasicReplayer(const std::string& a_path)
+{
+    // Read the whole file with as few reads as possible.
+    std::FILE* file = std::fopen(a_path.c_str(), "rb");
+    if (!file)
+    {
+        throw TraceError("Could not open trace file " + a_path);
+    }
+    char block[64 * 1024];
+    size_t read = 0;
+    while ((read = std::fread(block, 1, sizeof(block), file)) > 0)
+    {
+        m_data.insert(m_data.end(), block, block + read);
+    }
+    const bool failed = std::ferror(file) != 0;
+    std::fclose(file);
+    if (failed)
+    {
+        throw TraceError("Could not read trace file " + a_path);
+    }
+
+    const char* begin = m_data.data();
+    const char* data = begin;
+    const char* end = begin + m_data.size();
+    if (m_data.size() < sizeof(Recorder::Magic) ||
+        std::memcmp(data, Recorder::Magic, sizeof(Recorder::Magic)) != 0)
+    {
+        throw TraceError("Not a trace file " + a_path);
+    }
+    data += sizeof(Recorder::Magic);
+    if (TraceSerializer<uint32_t>::Read(data, end) != Recorder::Version)
+    {
+        throw TraceError("Unsupported trace file version " + a_path);
+    }
+    if (TraceSerializer<uint32_t>::Read(data, end) != sizeof...(Args))
+    {
+        throw TraceError("Trace file has a different event signature " + a_path);
+    }
+
+    while (data != end)
+    {
+        TraceRecord record;
+        record.m_time = std::chrono::nanoseconds(TraceSerializer<int64_t>::Read(data, end));
+        record.m_invoked = TraceSerializer<uint32_t>::Read(data, end);
+        record.m_consumed = TraceSerializer<uint8_t>::Read(data, end) != 0;
+        record.m_consumerSortIndex = TraceSerializer<int32_t>::Read(data, end);
+        const uint64_t size = TraceSerializer<uint64_t>::Read(data, end);
+        if (static_cast<uint64_t>(end - data) < size)
+        {
+            throw TraceError("Trace record is truncated");
+        }
+        m_records.push_back(record);
+        m_payloads.push_back({ static_cast<size_t>(data - begin), static_cast<size_t>(size) });
+        data += size;
+    }
+}
+
+//--------------------------------------------------------------
+//! Dispatches every event in the trace with a dispatcher, in the
+//! order they were recorded. Listeners are invoked exactly as they
+//! would be by Dispatch, so the listeners of the dispatcher decide
+//! the outcome of each event, which is compared with the record.
+//!
+//! \param[in] a_dispatcher Dispatcher to dispatch the events with.
+//! \param[in] a_speed Pace at which to dispatch the events.
+//! \return Number of events that invoked a different number of
+//!         listeners, or were consumed differently, than recorded.
+//! \throw DispatchDepthExceeded if nested deeper than the limit.
+//! \throw TraceError if the arguments of an event are malformed.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+size_t BasicReplayer<Policy, Args...>::Replay(Dispatcher& a_dispatcher,
+                                              ReplaySpeed a_speed) const
+{
+    size_t mismatches = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < m_records.size(); ++i)
+    {
+        const TraceRecord& recorded = m_records[i];
+        if (a_speed == ReplaySpeed::Original)
+        {
+            std::this_thread::sleep_until(start + recorded.m_time);
+        }
+
+        // Braced initialization reads the arguments in order.
+        const char* data = m_data.data() + m_payloads[i].m_offset;
+        const char* end = data + m_payloads[i].m_size;
+        const std::tuple<typename std::decay<Args>::type...> args
+        {
+            TraceSerializer<typename std::decay<Args>::type>::Read(data, end)...
+        };
+        if (data != end)
+        {
+            throw TraceError("Trace record has unexpected arguments");
+        }
+
+        const TraceRecord replayed = std::apply([&a_dispatcher](const auto&... a_values)
+        {
+            return Recorder::Deliver(a_dispatcher, a_values...);
+        }, args);
+        if (replayed.m_invoked != recorded.m_invoked ||
+            replayed.m_consumed != recorded.m_consumed ||
+            (replayed.m_consumed && replayed.m_consumerSortIndex != recorded.m_consumerSortIndex))
+        {
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+//--------------------------------------------------------------
+//! Records of what happened to each event when it was recorded,
+//! in the order they were recorded (eg. to analyze offline).
+//!
+//! \return Reference to the records of the trace.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+const std::vector<TraceRecord>& BasicReplayer<Policy, Args...>::Records() const
+{
+    return m_records;
+}
+
+//--------------------------------------------------------------
+//! Number of events in the trace.
+//!
+//! \return Number of events in the trace.
+//--------------------------------------------------------------
+template<class Policy, class... Args> inline
+size_t BasicReplayer<Policy, Args...>::Size() const
+{
+    return m_records.size();
+}
+
+} // namespace Event
+} // namespace Simple
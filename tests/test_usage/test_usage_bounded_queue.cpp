@@ -0,0 +1,205 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <simple/event/bounded_queue.h>
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Simple::Event;
+using namespace std;
+
+//--------------------------------------------------------------
+TEST_CASE("Test BoundedQueue Push Pop", "[bounded_queue][push]")
+{
+    BoundedQueue<unique_ptr<int>> queue(5);
+    REQUIRE(queue.Capacity() == 8);
+    REQUIRE(!queue.Pop());
+
+    // Items are popped in the order they were pushed.
+    for (int i = 0; i < 8; ++i)
+    {
+        REQUIRE(queue.Push(make_unique<int>(i)));
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        optional<unique_ptr<int>> item = queue.Pop();
+        REQUIRE(item);
+        REQUIRE(**item == i);
+    }
+    REQUIRE(!queue.Pop());
+
+    // The ring buffer wraps around.
+    for (int i = 0; i < 20; ++i)
+    {
+        REQUIRE(queue.Emplace(new int(i)));
+        REQUIRE(**queue.Pop() == i);
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test BoundedQueue Overflow", "[bounded_queue][overflow]")
+{
+    SECTION("Fail")
+    {
+        BoundedQueue<int> queue(4, Overflow::Fail);
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(queue.Push(i));
+        }
+        REQUIRE(!queue.Push(4));
+        REQUIRE(queue.DroppedCount() == 0);
+        REQUIRE(*queue.Pop() == 0);
+    }
+
+    SECTION("DropNewest")
+    {
+        BoundedQueue<int> queue(4, Overflow::DropNewest);
+        for (int i = 0; i < 6; ++i)
+        {
+            REQUIRE(queue.Push(i) == (i < 4));
+        }
+        REQUIRE(queue.DroppedCount() == 2);
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(*queue.Pop() == i);
+        }
+        REQUIRE(!queue.Pop());
+    }
+
+    SECTION("DropOldest")
+    {
+        BoundedQueue<int> queue(4, Overflow::DropOldest);
+        for (int i = 0; i < 6; ++i)
+        {
+            REQUIRE(queue.Push(i));
+        }
+        REQUIRE(queue.DroppedCount() == 2);
+        for (int i = 2; i < 6; ++i)
+        {
+            REQUIRE(*queue.Pop() == i);
+        }
+        REQUIRE(!queue.Pop());
+    }
+
+    SECTION("Block")
+    {
+        BoundedQueue<int> queue(4, Overflow::Block);
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(queue.Push(i));
+        }
+        thread producer([&queue]()
+        {
+            queue.Push(4);
+        });
+        int expected = 0;
+        while (expected < 5)
+        {
+            if (optional<int> item = queue.Pop())
+            {
+                REQUIRE(*item == expected++);
+            }
+        }
+        producer.join();
+        REQUIRE(queue.DroppedCount() == 0);
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test BoundedQueue Destroy", "[bounded_queue][destroy]")
+{
+    // Items left in the queue are destroyed along with it.
+    shared_ptr<int> item = make_shared<int>(0);
+    {
+        BoundedQueue<shared_ptr<int>> queue(4);
+        queue.Push(item);
+        queue.Push(item);
+        REQUIRE(item.use_count() == 3);
+    }
+    REQUIRE(item.use_count() == 1);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test BoundedQueue Thread", "[bounded_queue][thread]")
+{
+    const uint32_t numProducers = 4;
+    const uint32_t numItems = 10000;
+
+    SECTION("Single Consumer")
+    {
+        BoundedQueue<pair<uint32_t, uint32_t>> queue(64, Overflow::Block);
+        vector<thread> producers;
+        for (uint32_t i = 0; i < numProducers; ++i)
+        {
+            producers.emplace_back([&queue, i]()
+            {
+                for (uint32_t item = 0; item < numItems; ++item)
+                {
+                    queue.Emplace(i, item);
+                }
+            });
+        }
+
+        // Items from each producer must arrive in order.
+        vector<uint32_t> nextItems(numProducers, 0);
+        uint32_t outOfOrderCount = 0;
+        for (uint32_t popped = 0; popped < numProducers * numItems;)
+        {
+            if (optional<pair<uint32_t, uint32_t>> item = queue.Pop())
+            {
+                outOfOrderCount += (nextItems[item->first]++ != item->second);
+                ++popped;
+            }
+        }
+        for (thread& producer : producers)
+        {
+            producer.join();
+        }
+        REQUIRE(outOfOrderCount == 0);
+        REQUIRE(!queue.Pop());
+    }
+
+    SECTION("Multi Consumer")
+    {
+        BoundedQueue<uint32_t, true> queue(64, Overflow::Block);
+        atomic<uint64_t> poppedSum = { 0 };
+        atomic<uint32_t> poppedCount = { 0 };
+        vector<thread> threads;
+        for (uint32_t i = 0; i < numProducers; ++i)
+        {
+            threads.emplace_back([&queue]()
+            {
+                for (uint32_t item = 1; item <= numItems; ++item)
+                {
+                    queue.Push(item);
+                }
+            });
+            threads.emplace_back([&queue, &poppedSum, &poppedCount]()
+            {
+                while (poppedCount < numProducers * numItems)
+                {
+                    if (optional<uint32_t> item = queue.Pop())
+                    {
+                        poppedSum += *item;
+                        ++poppedCount;
+                    }
+                }
+            });
+        }
+        for (thread& thread : threads)
+        {
+            thread.join();
+        }
+        const uint64_t expectedSum = uint64_t(numItems) * (numItems + 1) / 2;
+        REQUIRE(poppedSum == expectedSum * numProducers);
+        REQUIRE(!queue.Pop());
+    }
+}
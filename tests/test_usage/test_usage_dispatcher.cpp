@@ -9,8 +9,14 @@
 #include <simple/event/dispatcher.h>
 #include <catch2/catch.hpp>
 #include <climits>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <memory>
+#include <memory_resource>
+#include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 using namespace Simple::Event;
@@ -500,6 +506,91 @@ TEST_CASE("Test Dispatcher multi", "[dispatcher][multi]")
     dispatcher.Dispatch(s_expectedStruct, "Another String", 3.14f, false);
 }
 
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Payload Copy", "[dispatcher][copy]")
+{
+    struct Payload
+    {
+        Payload(int& a_copies) : m_copies(a_copies) {}
+        Payload(const Payload& a_other) : m_copies(a_other.m_copies)
+        {
+            ++m_copies;
+        }
+
+        int& m_copies;
+    };
+
+    using TestDispatcher = Dispatcher<Payload>;
+    using TestFilter = TestDispatcher::Filter;
+    TestDispatcher dispatcher;
+    int invokedCount = 0;
+    vector<TestDispatcher::Listener> listeners;
+    for (int i = 0; i < 40; ++i)
+    {
+        listeners.push_back(dispatcher.Register([&invokedCount](const Payload&)
+        {
+            ++invokedCount;
+            return Status::Continue;
+        }, i));
+    }
+    listeners.push_back(dispatcher.Register(TestFilter([](const Payload&)
+    {
+        return true;
+    }, [&invokedCount](const Payload&)
+    {
+        ++invokedCount;
+        return Status::Continue;
+    })));
+
+    int copies = 0;
+    Payload payload(copies);
+    dispatcher.Dispatch(payload);
+    REQUIRE(invokedCount == 41);
+    REQUIRE(copies == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Move Only", "[dispatcher][copy]")
+{
+    using TestDispatcher = Dispatcher<unique_ptr<int>>;
+    TestDispatcher dispatcher;
+    int sum = 0;
+    TestDispatcher::Listener listener1 = dispatcher.Register([&sum](const unique_ptr<int>& a_value)
+    {
+        sum += *a_value;
+        return Status::Continue;
+    });
+    TestDispatcher::Listener listener2 = dispatcher.Register([&sum](const unique_ptr<int>& a_value)
+    {
+        sum += *a_value;
+        return Status::Continue;
+    });
+
+    dispatcher.Dispatch(unique_ptr<int>(new int(9)));
+    REQUIRE(sum == 18);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Mutable Reference", "[dispatcher][reference]")
+{
+    using TestDispatcher = Dispatcher<int&>;
+    TestDispatcher dispatcher;
+    TestDispatcher::Listener listener1 = dispatcher.Register([](int& a_value)
+    {
+        a_value += 1;
+        return Status::Continue;
+    });
+    TestDispatcher::Listener listener2 = dispatcher.Register([](int& a_value)
+    {
+        a_value *= 9;
+        return Status::Continue;
+    }, 1);
+
+    int value = 0;
+    dispatcher.Dispatch(value);
+    REQUIRE(value == 9);
+}
+
 //--------------------------------------------------------------
 TEST_CASE("Test Dispatcher Consume", "[dispatcher][consume]")
 {
@@ -568,6 +659,301 @@ TEST_CASE("Test Dispatcher Remove", "[dispatcher][remove]")
     dispatcher.Dispatch();
 }
 
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Remove Many", "[dispatcher][remove]")
+{
+    using TestDispatcher = Dispatcher<>;
+    TestDispatcher dispatcher;
+    TestDispatcher otherDispatcher;
+    const uint32_t numListeners = 1000;
+    vector<uint32_t> invokedCounts(numListeners, 0);
+    vector<TestDispatcher::Listener> listeners;
+    for (uint32_t i = 0; i < numListeners; ++i)
+    {
+        listeners.push_back(dispatcher.Register([&invokedCounts, i]()
+        {
+            ++invokedCounts[i];
+            return Status::Continue;
+        }, rand()));
+    }
+
+    // Only listeners registered with the dispatcher are removed.
+    REQUIRE(!otherDispatcher.Remove(listeners[0]));
+    REQUIRE(!dispatcher.Remove(nullptr));
+
+    // Remove every other listener, so compaction gets triggered.
+    for (uint32_t i = 0; i < numListeners; i += 2)
+    {
+        REQUIRE(dispatcher.Remove(listeners[i]));
+        REQUIRE(!dispatcher.Remove(listeners[i]));
+        if (i == numListeners / 2)
+        {
+            dispatcher.Dispatch();
+        }
+    }
+    dispatcher.Dispatch();
+
+    for (uint32_t i = 0; i < numListeners; ++i)
+    {
+        const uint32_t expectedCount = (i % 2) ? 2 : (i > numListeners / 2);
+        REQUIRE(invokedCounts[i] == expectedCount);
+    }
+
+    // The listener can still invoke its callable directly.
+    (*listeners[1])();
+    REQUIRE(invokedCounts[1] == 3);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Register Many", "[dispatcher][group]")
+{
+    using TestDispatcher = Dispatcher<int>;
+    TestDispatcher dispatcher;
+    TestDispatcher otherDispatcher;
+    vector<int> invoked;
+    auto listener = [&invoked](int a_id)
+    {
+        return [&invoked, a_id](const int&)
+        {
+            invoked.push_back(a_id);
+            return Status::Continue;
+        };
+    };
+    TestDispatcher::Listener listener0 = dispatcher.Register(listener(0), 0);
+    TestDispatcher::Listener listener4 = dispatcher.Register(listener(4), 2);
+
+    // Callables are registered in order, after existing listeners
+    // that share their sort index.
+    TestDispatcher::ListenerGroup group = dispatcher.RegisterMany({ listener(1), listener(2), listener(3) });
+    REQUIRE(group.Size() == 3);
+    dispatcher.Dispatch(0);
+    REQUIRE(invoked == vector<int>{ 0, 1, 2, 3, 4 });
+
+    // Connections made with the same dispatcher can be added.
+    REQUIRE(group.Add(dispatcher.Connect(listener(5), 3)));
+    REQUIRE(!group.Add(otherDispatcher.Connect(listener(6))));
+    REQUIRE(!group.Add(TestDispatcher::Connection()));
+    REQUIRE(group.Size() == 4);
+    invoked.clear();
+    dispatcher.Dispatch(0);
+    REQUIRE(invoked == vector<int>{ 0, 1, 2, 3, 4, 5 });
+
+    // Groups deregister all their listeners when assigned over,
+    // compacting the listeners once if most of them have expired.
+    TestDispatcher::ListenerGroup moved(move(group));
+    REQUIRE(group.Size() == 0);
+    invoked.clear();
+    dispatcher.Dispatch(0);
+    REQUIRE(invoked == vector<int>{ 0, 1, 2, 3, 4, 5 });
+    moved = dispatcher.RegisterMany({ listener(6) }, 1);
+    REQUIRE(dispatcher.ExpiredCount() == 0);
+    invoked.clear();
+    dispatcher.Dispatch(0);
+    REQUIRE(invoked == vector<int>{ 0, 6, 4 });
+
+    moved.Clear();
+    REQUIRE(moved.Size() == 0);
+    invoked.clear();
+    dispatcher.Dispatch(0);
+    REQUIRE(invoked == vector<int>{ 0, 4 });
+    REQUIRE(dispatcher.RegisterMany({}).Size() == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Register Many Thread", "[dispatcher][group]")
+{
+    using TestDispatcher = Dispatcher<int>;
+    const int numThreads = 4;
+    const int numListeners = 1000;
+    TestDispatcher dispatcher;
+    atomic<int> invokedCount = { 0 };
+    atomic<bool> finished = { false };
+    thread dispatching([&dispatcher, &finished]()
+    {
+        while (!finished)
+        {
+            dispatcher.Dispatch(0);
+        }
+    });
+
+    // Register then clear groups on many threads while dispatching.
+    vector<thread> threads;
+    for (int i = 0; i < numThreads; ++i)
+    {
+        threads.emplace_back([&dispatcher, &invokedCount, i]()
+        {
+            for (int j = 0; j < 10; ++j)
+            {
+                vector<TestDispatcher::Callable> callables(numListeners, [&invokedCount](const int&)
+                {
+                    ++invokedCount;
+                    return Status::Continue;
+                });
+                TestDispatcher::ListenerGroup group = dispatcher.RegisterMany(move(callables), i);
+            }
+        });
+    }
+    for (thread& registering : threads)
+    {
+        registering.join();
+    }
+    finished = true;
+    dispatching.join();
+
+    // Every listener has been deregistered and compacted.
+    const int count = invokedCount;
+    dispatcher.Dispatch(0);
+    REQUIRE(invokedCount == count);
+    dispatcher.Compact();
+    REQUIRE(dispatcher.ExpiredCount() == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Compact", "[dispatcher][remove]")
+{
+    using TestDispatcher = Dispatcher<>;
+    TestDispatcher dispatcher;
+    dispatcher.SetAutoCompact(false);
+    const uint32_t numListeners = 100;
+    uint32_t invokedCount = 0;
+    vector<TestDispatcher::Listener> listeners;
+    vector<TestDispatcher::Connection> connections;
+    for (uint32_t i = 0; i < numListeners; ++i)
+    {
+        listeners.push_back(dispatcher.Register([&invokedCount]()
+        {
+            ++invokedCount;
+            return Status::Continue;
+        }));
+        connections.push_back(dispatcher.Connect([&invokedCount]()
+        {
+            ++invokedCount;
+            return Status::Continue;
+        }));
+    }
+    REQUIRE(dispatcher.ExpiredCount() == 0);
+    REQUIRE(dispatcher.Compact() == 0);
+
+    // Expired listeners are skipped, but only pruned by Compact.
+    for (uint32_t i = 0; i < numListeners; ++i)
+    {
+        REQUIRE(dispatcher.Remove(listeners[i]));
+    }
+    connections.resize(numListeners / 2);
+    REQUIRE(dispatcher.ExpiredCount() == numListeners + numListeners / 2);
+    dispatcher.Dispatch();
+    REQUIRE(invokedCount == numListeners / 2);
+
+    REQUIRE(dispatcher.Compact() == numListeners + numListeners / 2);
+    REQUIRE(dispatcher.ExpiredCount() == 0);
+    REQUIRE(dispatcher.Compact() == 0);
+    dispatcher.Dispatch();
+    REQUIRE(invokedCount == numListeners);
+
+    // Removing most listeners compacts them again once enabled.
+    dispatcher.SetAutoCompact(true);
+    for (uint32_t i = 0; i < numListeners / 2; ++i)
+    {
+        REQUIRE(dispatcher.Remove(connections[i]));
+    }
+    REQUIRE(dispatcher.ExpiredCount() < numListeners / 2);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Connection", "[dispatcher][connection]")
+{
+    using TestDispatcher = Dispatcher<int>;
+    TestDispatcher dispatcher;
+    TestDispatcher otherDispatcher;
+    int invokedSum = 0;
+    TestDispatcher::Connection connection1 = dispatcher.Connect([&invokedSum](int a_int)
+    {
+        invokedSum += a_int;
+        return Status::Continue;
+    });
+    TestDispatcher::Connection connection2 = dispatcher.Connect([&invokedSum](int a_int)
+    {
+        invokedSum += a_int * 10;
+        return Status::Continue;
+    });
+    REQUIRE(connection1);
+    REQUIRE(connection2);
+
+    dispatcher.Dispatch(1);
+    REQUIRE(invokedSum == 11);
+
+    // Moving a connection keeps the callable registered.
+    TestDispatcher::Connection moved = std::move(connection1);
+    REQUIRE(!connection1);
+    REQUIRE(moved);
+    dispatcher.Dispatch(1);
+    REQUIRE(invokedSum == 22);
+
+    // Only connections registered with the dispatcher are removed.
+    REQUIRE(!otherDispatcher.Remove(moved));
+    REQUIRE(!dispatcher.Remove(connection1));
+    REQUIRE(dispatcher.Remove(connection2));
+    REQUIRE(!dispatcher.Remove(connection2));
+    dispatcher.Dispatch(1);
+    REQUIRE(invokedSum == 23);
+
+    // A removed connection can still invoke its callable directly.
+    REQUIRE(connection2(1) == Status::Continue);
+    REQUIRE(invokedSum == 33);
+
+    // Disconnecting (or destroying) the connection deregisters it.
+    moved.Disconnect();
+    REQUIRE(!moved);
+    REQUIRE(moved(1) == Status::Filtered);
+    dispatcher.Dispatch(1);
+    REQUIRE(invokedSum == 33);
+
+    {
+        TestDispatcher::Connection scoped = dispatcher.Connect([&invokedSum](int a_int)
+        {
+            invokedSum += a_int * 100;
+            return Status::Continue;
+        });
+        dispatcher.Dispatch(1);
+        REQUIRE(invokedSum == 133);
+    }
+    dispatcher.Dispatch(1);
+    REQUIRE(invokedSum == 133);
+
+    // Connections may outlive the dispatcher they were made with.
+    TestDispatcher::Connection orphan;
+    {
+        TestDispatcher scopedDispatcher;
+        orphan = scopedDispatcher.Connect([](int)
+        {
+            return Status::Consumed;
+        });
+    }
+    REQUIRE(orphan(1) == Status::Consumed);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Connection Release Self", "[dispatcher][connection]")
+{
+    using TestDispatcher = Dispatcher<>;
+    TestDispatcher dispatcher;
+    int invokedCount = 0;
+    TestDispatcher::Connection connection;
+    connection = dispatcher.Connect([&connection, &invokedCount]()
+    {
+        // Disconnect this connection then touch captured state.
+        connection.Disconnect();
+        ++invokedCount;
+        return Status::Continue;
+    });
+
+    dispatcher.Dispatch();
+    REQUIRE(invokedCount == 1);
+
+    dispatcher.Dispatch();
+    REQUIRE(invokedCount == 1);
+}
+
 //--------------------------------------------------------------
 TEST_CASE("Test Dispatcher Recursive", "[dispatcher][recursive]")
 {
@@ -630,6 +1016,613 @@ TEST_CASE("Test Dispatcher Recursive", "[dispatcher][recursive]")
     REQUIRE(invokedCount == 3);
 }
 
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Recursive Depth", "[dispatcher][recursive]")
+{
+    using TestDispatcher = Dispatcher<int>;
+    TestDispatcher dispatcher;
+    size_t maxDepth = 0;
+    TestDispatcher::Listener listener = dispatcher.Register([&dispatcher, &maxDepth](const int& a_remaining)
+    {
+        maxDepth = max(maxDepth, DispatchDepth::Current());
+        if (a_remaining > 0)
+        {
+            dispatcher.Dispatch(a_remaining - 1);
+        }
+        return Status::Continue;
+    });
+    REQUIRE(DispatchDepth::Current() == 0);
+
+    // Nested dispatches are counted on the calling thread.
+    HazardPointer::Reserve(8);
+    dispatcher.Dispatch(3);
+    REQUIRE(maxDepth == 4);
+    REQUIRE(DispatchDepth::Current() == 0);
+
+    // Nesting deeper than the limit fails loudly, and unwinds.
+    const size_t limit = DispatchDepth::Limit();
+    DispatchDepth::SetLimit(4);
+    REQUIRE(DispatchDepth::Limit() == 4);
+    dispatcher.Dispatch(3);
+    REQUIRE_THROWS_AS(dispatcher.Dispatch(4), DispatchDepthExceeded);
+    REQUIRE(DispatchDepth::Current() == 0);
+    DispatchDepth::SetLimit(limit);
+    dispatcher.Dispatch(4);
+    REQUIRE(maxDepth == 5);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Release Self", "[dispatcher][release]")
+{
+    using TestDispatcher = Dispatcher<>;
+    TestDispatcher dispatcher;
+    int invokedCount = 0;
+    TestDispatcher::Listener listener1;
+    TestDispatcher::Listener listener2;
+    listener1 = dispatcher.Register([&listener1, &invokedCount]()
+    {
+        // Release this listener then touch captured state.
+        listener1 = nullptr;
+        ++invokedCount;
+        return Status::Continue;
+    });
+    listener2 = dispatcher.Register([&listener2, &invokedCount]()
+    {
+        // Release this listener then consume the event.
+        listener2.reset();
+        ++invokedCount;
+        return Status::Consumed;
+    });
+
+    dispatcher.Dispatch();
+    REQUIRE(invokedCount == 2);
+
+    dispatcher.Dispatch();
+    REQUIRE(invokedCount == 2);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher No Copy", "[dispatcher][copy]")
+{
+    struct CopyCounter
+    {
+        CopyCounter(int& a_copies) : m_copies(a_copies) {}
+        CopyCounter(const CopyCounter& a_other) : m_copies(a_other.m_copies)
+        {
+            ++m_copies;
+        }
+
+        Status operator()() const { return Status::Continue; }
+
+        int& m_copies;
+    };
+
+    using TestDispatcher = Dispatcher<>;
+    TestDispatcher dispatcher;
+    int copies = 0;
+    TestDispatcher::Listener listener1 = dispatcher.Register(CopyCounter(copies));
+    TestDispatcher::Listener listener2 = dispatcher.Register(CopyCounter(copies), -1);
+
+    copies = 0;
+    dispatcher.Dispatch();
+    dispatcher.Dispatch();
+    REQUIRE(copies == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Dispatch For", "[dispatcher][budget]")
+{
+    using TestDispatcher = Dispatcher<int>;
+    TestDispatcher dispatcher;
+    vector<int> invoked;
+    auto listener = [&invoked](int a_id)
+    {
+        return [&invoked, a_id](const int& a_int)
+        {
+            invoked.push_back(a_id);
+            return a_int == a_id ? Status::Consumed : Status::Continue;
+        };
+    };
+    TestDispatcher::Listener listener1 = dispatcher.Register(listener(1), 1);
+    TestDispatcher::Listener listener2 = dispatcher.Register(listener(2), 0);
+    TestDispatcher::Listener listener3 = dispatcher.Register(listener(3), 1);
+    TestDispatcher::Listener listener4 = dispatcher.Register(listener(4), 2);
+
+    // With no budget, each call invokes a single listener.
+    TestDispatcher::Cursor cursor = dispatcher.DispatchFor(chrono::nanoseconds(0), 0);
+    REQUIRE(invoked == vector<int>{ 2 });
+    REQUIRE(!cursor.Done());
+    REQUIRE(!dispatcher.Resume(cursor, chrono::nanoseconds(0)));
+    REQUIRE(invoked == vector<int>{ 2, 1 });
+
+    // Listeners removed before resuming are skipped, and listeners
+    // registered after the dispatch began are not invoked by it.
+    dispatcher.Remove(listener3);
+    TestDispatcher::Listener listener5 = dispatcher.Register(listener(5), 1);
+    REQUIRE(dispatcher.Resume(cursor, chrono::nanoseconds(0)));
+    REQUIRE(invoked == vector<int>{ 2, 1, 4 });
+    REQUIRE(cursor.Done());
+    REQUIRE(!cursor.Consumed());
+    REQUIRE(dispatcher.Resume(cursor, chrono::nanoseconds(0)));
+    REQUIRE(invoked == vector<int>{ 2, 1, 4 });
+
+    // With enough budget, the dispatch is done in one call.
+    invoked.clear();
+    cursor = dispatcher.DispatchFor(chrono::seconds(10), 0);
+    REQUIRE(cursor.Done());
+    REQUIRE(invoked == vector<int>{ 2, 1, 5, 4 });
+
+    // Consuming the event is kept across resumes.
+    invoked.clear();
+    cursor = dispatcher.DispatchFor(chrono::nanoseconds(0), 1);
+    REQUIRE(!cursor.Done());
+    REQUIRE(dispatcher.Resume(cursor, chrono::nanoseconds(0)));
+    REQUIRE(cursor.Consumed());
+    REQUIRE(dispatcher.Resume(cursor, chrono::nanoseconds(0)));
+    REQUIRE(invoked == vector<int>{ 2, 1 });
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Queued", "[dispatcher][queued]")
+{
+    using TestDispatcher = Dispatcher<int, string>;
+    TestDispatcher dispatcher;
+    dispatcher.Reserve(4);
+    vector<string> received;
+    TestDispatcher::Listener listener = dispatcher.Register([&received](int a_int, const string& a_string)
+    {
+        received.push_back(to_string(a_int) + a_string);
+        return Status::Continue;
+    });
+
+    // Enqueuing does not invoke any listeners.
+    for (int i = 0; i < 10; ++i)
+    {
+        dispatcher.Enqueue(i, "a");
+    }
+    REQUIRE(received.empty());
+
+    // Events are delivered in order, up to the maximum requested.
+    REQUIRE(dispatcher.Process(3) == 3);
+    REQUIRE(received == vector<string>({ "0a", "1a", "2a" }));
+    dispatcher.Enqueue(10, "b");
+    REQUIRE(dispatcher.Flush() == 8);
+    REQUIRE(received.size() == 11);
+    REQUIRE(received[9] == "9a");
+    REQUIRE(received[10] == "10b");
+    REQUIRE(dispatcher.Flush() == 0);
+    REQUIRE(dispatcher.Process(5) == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Queued Snapshot", "[dispatcher][queued]")
+{
+    using TestDispatcher = Dispatcher<int>;
+    TestDispatcher dispatcher;
+    int invokedCount1 = 0;
+    int invokedCount2 = 0;
+    int invokedCount3 = 0;
+    TestDispatcher::Listener listener1;
+    TestDispatcher::Listener listener2;
+    TestDispatcher::Listener listener3;
+    listener1 = dispatcher.Register([&](int a_int)
+    {
+        ++invokedCount1;
+        if (a_int == 1)
+        {
+            // Register a listener and release one mid-flush,
+            // and enqueue another event for the next flush.
+            listener3 = dispatcher.Register([&invokedCount3](int)
+            {
+                ++invokedCount3;
+                return Status::Continue;
+            });
+            listener2 = nullptr;
+            dispatcher.Enqueue(3);
+        }
+        return Status::Continue;
+    }, -1);
+    listener2 = dispatcher.Register([&invokedCount2](int a_int)
+    {
+        ++invokedCount2;
+        return a_int == 0 ? Status::Consumed : Status::Continue;
+    });
+
+    dispatcher.Enqueue(0);
+    dispatcher.Enqueue(1);
+    dispatcher.Enqueue(2);
+    REQUIRE(dispatcher.Flush() == 3);
+    REQUIRE(invokedCount1 == 3);
+    REQUIRE(invokedCount2 == 2);
+    REQUIRE(invokedCount3 == 0);
+
+    REQUIRE(dispatcher.Flush() == 1);
+    REQUIRE(invokedCount1 == 4);
+    REQUIRE(invokedCount2 == 2);
+    REQUIRE(invokedCount3 == 1);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Queued Thread", "[dispatcher][queued]")
+{
+    using TestDispatcher = Dispatcher<uint32_t, uint32_t>;
+    TestDispatcher dispatcher;
+    const uint32_t numProducers = 4;
+    const uint32_t numEvents = 10000;
+    vector<uint32_t> nextEvents(numProducers, 0);
+    uint32_t outOfOrderCount = 0;
+    TestDispatcher::Listener listener = dispatcher.Register([&](uint32_t a_producer, uint32_t a_event)
+    {
+        // Events from each producer must arrive in order.
+        if (nextEvents[a_producer]++ != a_event)
+        {
+            ++outOfOrderCount;
+        }
+        return Status::Continue;
+    });
+
+    vector<thread> producers;
+    for (uint32_t i = 0; i < numProducers; ++i)
+    {
+        producers.emplace_back([&dispatcher, i]()
+        {
+            for (uint32_t event = 0; event < numEvents; ++event)
+            {
+                dispatcher.Enqueue(i, event);
+            }
+        });
+    }
+
+    // Consume events while they are being produced.
+    size_t processedCount = 0;
+    while (processedCount < numProducers * numEvents)
+    {
+        processedCount += dispatcher.Process(100);
+    }
+    for (thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    REQUIRE(outOfOrderCount == 0);
+    REQUIRE(dispatcher.Flush() == 0);
+    for (uint32_t i = 0; i < numProducers; ++i)
+    {
+        REQUIRE(nextEvents[i] == numEvents);
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Batch", "[dispatcher][batch]")
+{
+    using TestDispatcher = Dispatcher<uint32_t>;
+    const uint32_t numEvents = 150;
+    vector<TestDispatcher::Event> events;
+    for (uint32_t i = 0; i < numEvents; ++i)
+    {
+        events.emplace_back(i);
+    }
+
+    for (const BatchOrder order : { BatchOrder::EventMajor, BatchOrder::ListenerMajor })
+    {
+        TestDispatcher dispatcher;
+        vector<pair<int, uint32_t>> received;
+        TestDispatcher::Listener listener1 = dispatcher.Register([&received](uint32_t a_event)
+        {
+            // Consume every third event.
+            received.emplace_back(1, a_event);
+            return (a_event % 3 == 0) ? Status::Consumed : Status::Continue;
+        }, -1);
+        TestDispatcher::Listener listener2 = dispatcher.Register([&received](uint32_t a_event)
+        {
+            received.emplace_back(2, a_event);
+            return Status::Continue;
+        });
+
+        dispatcher.DispatchBatch(events, order);
+
+        // Each listener receives every unconsumed event in order.
+        vector<uint32_t> received1;
+        vector<uint32_t> received2;
+        for (const pair<int, uint32_t>& event : received)
+        {
+            (event.first == 1 ? received1 : received2).push_back(event.second);
+        }
+        REQUIRE(received1.size() == numEvents);
+        REQUIRE(received2.size() == numEvents - numEvents / 3);
+        for (uint32_t i = 0; i < numEvents; ++i)
+        {
+            REQUIRE(received1[i] == i);
+        }
+        for (size_t i = 1; i < received2.size(); ++i)
+        {
+            REQUIRE(received2[i - 1] < received2[i]);
+            REQUIRE(received2[i] % 3 != 0);
+        }
+
+        // Listener major order sends all events to each listener.
+        if (order == BatchOrder::ListenerMajor)
+        {
+            REQUIRE(received[63].first == 1);
+            REQUIRE(received[64].first == 2);
+        }
+        else
+        {
+            REQUIRE(received[1].first == 1);
+            REQUIRE(received[2].first == 2);
+        }
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Batch Snapshot", "[dispatcher][batch]")
+{
+    using TestDispatcher = Dispatcher<int>;
+    TestDispatcher dispatcher;
+    int invokedCount1 = 0;
+    int invokedCount2 = 0;
+    TestDispatcher::Listener listener2;
+    TestDispatcher::Listener listener1 = dispatcher.Register([&](int)
+    {
+        // Register a listener during the batch.
+        if (++invokedCount1 == 1)
+        {
+            listener2 = dispatcher.Register([&invokedCount2](int)
+            {
+                ++invokedCount2;
+                return Status::Continue;
+            });
+        }
+        return Status::Continue;
+    });
+
+    const TestDispatcher::Event events[] = { 1, 2, 3 };
+    dispatcher.DispatchBatch(events, 3, BatchOrder::ListenerMajor);
+    REQUIRE(invokedCount1 == 3);
+    REQUIRE(invokedCount2 == 0);
+
+    dispatcher.DispatchBatch(events, 0);
+    dispatcher.DispatchBatch(events, 3);
+    REQUIRE(invokedCount1 == 6);
+    REQUIRE(invokedCount2 == 3);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Drain", "[dispatcher][drain]")
+{
+    using TestDispatcher = Dispatcher<uint32_t, uint32_t>;
+    TestDispatcher dispatcher;
+    BoundedQueue<TestDispatcher::Event> queue(256, Overflow::Block);
+    const uint32_t numProducers = 4;
+    const uint32_t numEvents = 10000;
+    vector<uint32_t> nextEvents(numProducers, 0);
+    uint32_t outOfOrderCount = 0;
+    TestDispatcher::Listener listener = dispatcher.Register([&](uint32_t a_producer, uint32_t a_event)
+    {
+        // Events from each producer must arrive in order.
+        if (nextEvents[a_producer]++ != a_event)
+        {
+            ++outOfOrderCount;
+        }
+        return Status::Continue;
+    });
+
+    // Producers post events without locking.
+    vector<thread> producers;
+    for (uint32_t i = 0; i < numProducers; ++i)
+    {
+        producers.emplace_back([&queue, i]()
+        {
+            for (uint32_t event = 0; event < numEvents; ++event)
+            {
+                queue.Emplace(i, event);
+            }
+        });
+    }
+
+    // Drain events while they are being produced.
+    size_t drainedCount = 0;
+    while (drainedCount < numProducers * numEvents)
+    {
+        drainedCount += dispatcher.Drain(queue, 100);
+    }
+    for (thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    REQUIRE(outOfOrderCount == 0);
+    REQUIRE(dispatcher.Drain(queue) == 0);
+    for (uint32_t i = 0; i < numProducers; ++i)
+    {
+        REQUIRE(nextEvents[i] == numEvents);
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Async", "[dispatcher][async]")
+{
+    // Executor that runs tasks when asked to.
+    struct TestExecutor : Executor
+    {
+        void Execute(Task a_task) override { m_tasks.push_back(move(a_task)); }
+        vector<Task> m_tasks;
+    };
+
+    using TestDispatcher = Dispatcher<string>;
+    TestDispatcher dispatcher;
+    TestExecutor executor;
+    vector<int> invoked;
+    TestDispatcher::Listener listener1 = dispatcher.Register([&invoked](const string& a_string)
+    {
+        invoked.push_back(1);
+        return a_string == "consume" ? Status::Consumed : Status::Continue;
+    }, -1);
+    TestDispatcher::Listener listener2 = dispatcher.Register([&invoked](const string&)
+    {
+        invoked.push_back(2);
+        return Status::Continue;
+    });
+
+    // Events are copied, and not delivered until the task is run.
+    string payload = "consume";
+    Completion completion1 = dispatcher.DispatchAsync(executor, payload);
+    payload = "continue";
+    Completion completion2 = dispatcher.DispatchAsync(executor, payload);
+    REQUIRE(completion1);
+    REQUIRE(!completion1.Ready());
+    REQUIRE(executor.m_tasks.size() == 2);
+    REQUIRE(invoked.empty());
+
+    // Listeners are invoked in priority order, and consume events.
+    executor.m_tasks[0]();
+    REQUIRE(completion1.Ready());
+    REQUIRE(completion1.Consumed());
+    REQUIRE(invoked == vector<int>{ 1 });
+
+    // Listeners released before the task is run are not invoked.
+    listener1 = nullptr;
+    executor.m_tasks[1]();
+    REQUIRE(completion2.Ready());
+    REQUIRE(!completion2.Consumed());
+    REQUIRE(invoked == vector<int>{ 1, 2 });
+
+    // Empty completions are complete and not consumed.
+    Completion completion3;
+    REQUIRE(!completion3);
+    REQUIRE(completion3.Ready());
+    completion3.Wait();
+    REQUIRE(!completion3.Consumed());
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Async Thread", "[dispatcher][async]")
+{
+    using TestDispatcher = Dispatcher<int>;
+    TestDispatcher dispatcher;
+    const int numEvents = 1000;
+    atomic<int> invokedCount1 = { 0 };
+    atomic<int> invokedCount2 = { 0 };
+    TestDispatcher::Listener listener1 = dispatcher.Register([&invokedCount1](int a_int)
+    {
+        ++invokedCount1;
+        return a_int % 2 ? Status::Consumed : Status::Continue;
+    });
+    TestDispatcher::Listener listener2 = dispatcher.Register([&invokedCount2](int)
+    {
+        ++invokedCount2;
+        return Status::Continue;
+    }, 1);
+
+    // Deliver events on the default thread pool, and on another.
+    ThreadPool threadPool(2);
+    vector<Completion> completions;
+    for (int i = 0; i < numEvents; ++i)
+    {
+        completions.push_back(i < numEvents / 2 ? dispatcher.DispatchAsync(i) :
+                                                  dispatcher.DispatchAsync(threadPool, i));
+    }
+    for (int i = 0; i < numEvents; ++i)
+    {
+        REQUIRE(completions[i].Consumed() == (i % 2 != 0));
+    }
+    REQUIRE(invokedCount1 == numEvents);
+    REQUIRE(invokedCount2 == numEvents / 2);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Parallel", "[dispatcher][parallel]")
+{
+    using TestDispatcher = Dispatcher<int>;
+    TestDispatcher dispatcher;
+    ThreadPool threadPool(4);
+    const int numListeners = 8;
+    atomic<int> invokedCount0 = { 0 };
+    atomic<int> invokedCount1 = { 0 };
+    atomic<int> invokedCount2 = { 0 };
+    atomic<int> waitingCount = { 0 };
+    atomic<bool> bandsOverlapped = { false };
+    vector<TestDispatcher::Listener> listeners;
+    for (int i = 0; i < numListeners; ++i)
+    {
+        listeners.push_back(dispatcher.Register([&, i](int a_int)
+        {
+            // Wait (for a while) until two listeners run at once.
+            const auto timeout = chrono::steady_clock::now() + chrono::seconds(5);
+            ++waitingCount;
+            while (waitingCount < 2 && chrono::steady_clock::now() < timeout)
+            {
+                this_thread::yield();
+            }
+            ++invokedCount0;
+            return (a_int == 1 && i == 0) ? Status::Consumed : Status::Continue;
+        }));
+        listeners.push_back(dispatcher.Register([&](int)
+        {
+            // Each band only starts once the previous has finished.
+            if (invokedCount0 % numListeners != 0)
+            {
+                bandsOverlapped = true;
+            }
+            ++invokedCount1;
+            return Status::Continue;
+        }, 1));
+    }
+    listeners.push_back(dispatcher.Register([&invokedCount2](int)
+    {
+        ++invokedCount2;
+        return Status::Continue;
+    }, 2));
+
+    dispatcher.DispatchParallel(threadPool, 0);
+    REQUIRE(waitingCount >= 2);
+    REQUIRE(!bandsOverlapped);
+    REQUIRE(invokedCount0 == numListeners);
+    REQUIRE(invokedCount1 == numListeners);
+    REQUIRE(invokedCount2 == 1);
+
+    // Consuming the event still runs the rest of the band.
+    dispatcher.DispatchParallel(threadPool, 1);
+    REQUIRE(invokedCount0 == numListeners * 2);
+    REQUIRE(invokedCount1 == numListeners);
+    REQUIRE(invokedCount2 == 1);
+
+    // Released listeners are not invoked.
+    listeners.resize(1);
+    dispatcher.DispatchParallel(0);
+    REQUIRE(invokedCount0 == numListeners * 2 + 1);
+    REQUIRE(invokedCount1 == numListeners);
+    REQUIRE(invokedCount2 == 1);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Parallel Nested", "[dispatcher][parallel]")
+{
+    // Parallel dispatches from tasks of a saturated executor run
+    // their listeners on the calling thread instead of waiting.
+    using TestDispatcher = Dispatcher<int>;
+    TestDispatcher dispatcher;
+    ThreadPool threadPool(1);
+    atomic<int> invokedCount = { 0 };
+    vector<TestDispatcher::Listener> listeners;
+    for (int i = 0; i < 4; ++i)
+    {
+        listeners.push_back(dispatcher.Register([&](int a_int)
+        {
+            ++invokedCount;
+            if (a_int > 0)
+            {
+                dispatcher.DispatchParallel(threadPool, a_int - 1);
+            }
+            return Status::Continue;
+        }));
+    }
+
+    Completion completion = dispatcher.DispatchAsync(threadPool, 2);
+    REQUIRE(!completion.Consumed());
+    REQUIRE(invokedCount == 4 + 16 + 64);
+}
+
 //--------------------------------------------------------------
 TEST_CASE("Test Dispatcher Priority", "[dispatcher][priority]")
 {
@@ -658,6 +1651,40 @@ TEST_CASE("Test Dispatcher Priority", "[dispatcher][priority]")
     dispatcher.Dispatch();
 }
 
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Priority Stable", "[dispatcher][priority]")
+{
+    using TestDispatcher = Dispatcher<>;
+    TestDispatcher dispatcher;
+    vector<int> invokedOrder;
+    vector<TestDispatcher::Listener> listeners;
+    const int sortIndices[] = { 1, 0, 1, -1, 0, 1, -1, 0 };
+    for (int i = 0; i < 8; ++i)
+    {
+        listeners.push_back(dispatcher.Register([&invokedOrder, i]()
+        {
+            invokedOrder.push_back(i);
+            return Status::Continue;
+        }, sortIndices[i]));
+    }
+
+    // Equal sort indices are invoked in the order registered.
+    dispatcher.Dispatch();
+    REQUIRE(invokedOrder == vector<int>({ 3, 6, 1, 4, 7, 0, 2, 5 }));
+
+    // Order is kept as expired listeners are compacted away.
+    listeners[4] = nullptr;
+    listeners[6] = nullptr;
+    listeners.push_back(dispatcher.Register([&invokedOrder]()
+    {
+        invokedOrder.push_back(8);
+        return Status::Continue;
+    }));
+    invokedOrder.clear();
+    dispatcher.Dispatch();
+    REQUIRE(invokedOrder == vector<int>({ 3, 1, 7, 8, 0, 2, 5 }));
+}
+
 //--------------------------------------------------------------
 TEST_CASE("Test Dispatcher Thread", "[dispatcher][thread]")
 {
@@ -707,6 +1734,100 @@ TEST_CASE("Test Dispatcher Thread", "[dispatcher][thread]")
     REQUIRE(invokedCount == numThreads);
 }
 
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Snapshot", "[dispatcher][snapshot]")
+{
+    using TestDispatcher = Dispatcher<>;
+    TestDispatcher dispatcher;
+    const uint32_t numThreads = 16;
+    const uint32_t numDispatches = 1000;
+    atomic<uint32_t> invokedCount = { 0 };
+    atomic<bool> dispatching = { true };
+
+    // Always registered, so should be invoked by every dispatch.
+    TestDispatcher::Listener listener = dispatcher.Register([&invokedCount]()
+    {
+        ++invokedCount;
+        return Status::Continue;
+    });
+
+    // Dispatch from many threads at once.
+    vector<thread> threads;
+    for (uint32_t i = 0; i < numThreads; ++i)
+    {
+        threads.emplace_back([&dispatcher]()
+        {
+            for (uint32_t j = 0; j < numDispatches; ++j)
+            {
+                dispatcher.Dispatch();
+            }
+        });
+    }
+
+    // Keep publishing new snapshots while the threads dispatch.
+    thread churnThread([&dispatcher, &dispatching]()
+    {
+        while (dispatching)
+        {
+            TestDispatcher::Listener churn = dispatcher.Register([]()
+            {
+                return Status::Continue;
+            }, rand());
+            dispatcher.Remove(churn);
+        }
+    });
+
+    // Join all the threads.
+    for (thread& testThread : threads)
+    {
+        testThread.join();
+    }
+    dispatching = false;
+    churnThread.join();
+    REQUIRE(invokedCount == numThreads * numDispatches);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Inplace Policy", "[dispatcher][policy]")
+{
+    using TestDispatcher = BasicDispatcher<InplacePolicy<>, float>;
+    TestDispatcher dispatcher;
+    TestClass testClass;
+    int invokedCount = 0;
+
+    TestDispatcher::Listener listener0 = dispatcher.Register(testClass);
+    TestDispatcher::Listener listener1 = dispatcher.Register(TestFreeFunctionFloatArg);
+    TestDispatcher::Listener listener2 = dispatcher.Register(bind(&TestClass::TestClassFunctionFloatRefArg, &testClass, placeholders::_1));
+    TestDispatcher::Listener listener3 = dispatcher.Register([&testClass, &invokedCount](float a_float)
+    {
+        testClass.TestClassFunctionFloatArg(a_float);
+        ++invokedCount;
+        return Status::Continue;
+    });
+
+    s_expectedFloat = 9.0f;
+    dispatcher.Dispatch(9.0f);
+    REQUIRE(invokedCount == 1);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Move Only Policy", "[dispatcher][policy]")
+{
+    using TestDispatcher = BasicDispatcher<MoveOnlyPolicy<>, int>;
+    TestDispatcher dispatcher;
+    int sum = 0;
+
+    unique_ptr<int> value(new int(9));
+    TestDispatcher::Listener listener = dispatcher.Register([value = move(value), &sum](const int& a_int)
+    {
+        sum += *value + a_int;
+        return Status::Continue;
+    });
+
+    dispatcher.Dispatch(1);
+    REQUIRE(sum == 10);
+}
+
 //--------------------------------------------------------------
 bool TestFilterFunction(float a_float)
 {
@@ -717,6 +1838,199 @@ bool TestFilterFunction(float a_float)
     return a_float >= 0.0f ? true : false;
 }
 
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Instrumented Policy", "[dispatcher][policy]")
+{
+    using TestDispatcher = BasicDispatcher<InstrumentedPolicy<>, int>;
+    TestDispatcher dispatcher;
+    TestDispatcher::Listener listener1 = dispatcher.Register(TestDispatcher::Filter([](const int& a_int)
+    {
+        return a_int != 0;
+    }, [](const int& a_int)
+    {
+        return a_int == 1 ? Status::Consumed : Status::Continue;
+    }), -1);
+    TestDispatcher::Connection connection2 = dispatcher.Connect([](const int&)
+    {
+        this_thread::sleep_for(chrono::milliseconds(2));
+        return Status::Continue;
+    });
+    TestDispatcher::Listener listener3 = dispatcher.Register([](const int&)
+    {
+        return Status::Continue;
+    }, 1);
+
+    dispatcher.Dispatch(0);
+    dispatcher.Dispatch(1);
+    dispatcher.Dispatch(2);
+    const TestDispatcher::Event events[] = { 3, 4 };
+    dispatcher.DispatchBatch(events, 2);
+    dispatcher.Enqueue(5);
+    dispatcher.Flush();
+
+    // Listeners count how often they returned each status.
+    const ListenerStatistics statistics1 = listener1->Statistics();
+    REQUIRE(statistics1.m_sortIndex == -1);
+    REQUIRE(statistics1.m_invocations == 6);
+    REQUIRE(statistics1.m_continued == 4);
+    REQUIRE(statistics1.m_consumed == 1);
+    REQUIRE(statistics1.m_filtered == 1);
+
+    // Listeners record the total and maximum time spent in them.
+    const ListenerStatistics statistics2 = connection2.Statistics();
+    REQUIRE(statistics2.m_invocations == 5);
+    REQUIRE(statistics2.m_continued == 5);
+    REQUIRE(statistics2.m_maxTime >= chrono::milliseconds(2));
+    REQUIRE(statistics2.m_totalTime >= chrono::milliseconds(10));
+    REQUIRE(statistics2.m_totalTime >= statistics2.m_maxTime);
+
+    // Statistics for all listeners are collected in priority order.
+    const vector<ListenerStatistics> statistics = dispatcher.CollectListenerStatistics();
+    REQUIRE(statistics.size() == 3);
+    REQUIRE(statistics[0].m_invocations == 6);
+    REQUIRE(statistics[1].m_invocations == 5);
+    REQUIRE(statistics[2].m_sortIndex == 1);
+    REQUIRE(statistics[2].m_invocations == 5);
+
+    // The dispatcher counts events dispatched and pruned listeners.
+    REQUIRE(dispatcher.Statistics().m_dispatches == 6);
+    REQUIRE(dispatcher.Statistics().m_prunedListeners == 0);
+    dispatcher.Remove(listener1);
+    dispatcher.Remove(connection2);
+    REQUIRE(dispatcher.CollectListenerStatistics().size() == 1);
+    REQUIRE(dispatcher.Statistics().m_prunedListeners == 2);
+    REQUIRE(dispatcher.Statistics().m_lockWaitTime >= chrono::nanoseconds(0));
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Single Threaded Policy", "[dispatcher][policy]")
+{
+    using TestDispatcher = BasicDispatcher<SingleThreadedPolicy<>, int>;
+    TestDispatcher dispatcher;
+    vector<int> invoked;
+    TestDispatcher::Listener listener2;
+    TestDispatcher::Connection connection3;
+
+    // Listeners can register and remove listeners while invoked,
+    // and dispatch events, without locking or freeing snapshots
+    // that the dispatch is still reading from.
+    TestDispatcher::Listener listener1 = dispatcher.Register([&](const int& a_int)
+    {
+        invoked.push_back(1);
+        if (a_int == 0)
+        {
+            listener2 = dispatcher.Register([&invoked](const int&)
+            {
+                invoked.push_back(2);
+                return Status::Continue;
+            }, 2);
+            connection3 = dispatcher.Connect([&invoked](const int&)
+            {
+                invoked.push_back(3);
+                return Status::Continue;
+            }, 1);
+            dispatcher.Dispatch(1);
+        }
+        else if (a_int == 2)
+        {
+            dispatcher.Remove(listener2);
+            connection3.Disconnect();
+        }
+        return Status::Continue;
+    });
+
+    dispatcher.Dispatch(0);
+    REQUIRE(invoked == vector<int>{ 1, 1, 3, 2 });
+
+    // Listeners removed while dispatching are still invoked by it.
+    invoked.clear();
+    dispatcher.Dispatch(2);
+    REQUIRE(invoked == vector<int>{ 1, 3, 2 });
+    invoked.clear();
+    dispatcher.Dispatch(1);
+    REQUIRE(invoked == vector<int>{ 1 });
+
+    invoked.clear();
+    dispatcher.Enqueue(3);
+    dispatcher.Enqueue(4);
+    REQUIRE(dispatcher.Flush() == 2);
+    REQUIRE(invoked == vector<int>{ 1, 1 });
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Shared Mutex Policy", "[dispatcher][policy]")
+{
+    using TestDispatcher = BasicDispatcher<SharedMutexPolicy<InplacePolicy<>>, int>;
+    const int numThreads = 4;
+    const int numDispatches = 1000;
+    TestDispatcher dispatcher;
+    atomic<int> invokedCount = { 0 };
+    TestDispatcher::Listener listener = dispatcher.Register([&invokedCount](const int&)
+    {
+        ++invokedCount;
+        return Status::Continue;
+    });
+
+    // Register and release listeners while threads dispatch events.
+    vector<thread> threads;
+    for (int i = 0; i < numThreads; ++i)
+    {
+        threads.emplace_back([&dispatcher]()
+        {
+            for (int j = 0; j < numDispatches; ++j)
+            {
+                dispatcher.Dispatch(j);
+            }
+        });
+    }
+    for (int i = 0; i < numDispatches; ++i)
+    {
+        TestDispatcher::Connection connection = dispatcher.Connect([](const int&)
+        {
+            return Status::Continue;
+        }, i % 3);
+    }
+    for (thread& dispatching : threads)
+    {
+        dispatching.join();
+    }
+    REQUIRE(invokedCount == numThreads * numDispatches);
+    dispatcher.Compact();
+    REQUIRE(dispatcher.ExpiredCount() == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Dispatcher Memory Resource", "[dispatcher][resource]")
+{
+    using TestDispatcher = Dispatcher<int>;
+    vector<char> buffer(64 * 1024);
+    pmr::monotonic_buffer_resource arena(buffer.data(),
+                                         buffer.size(),
+                                         pmr::null_memory_resource());
+    int sum = 0;
+    {
+        // All memory comes from the arena, which never allocates.
+        TestDispatcher dispatcher(&arena);
+        TestDispatcher::Listener listener = dispatcher.Register([&sum](const int& a_value)
+        {
+            sum += a_value;
+            return Status::Continue;
+        });
+        TestDispatcher::Connection connection = dispatcher.Connect([&sum](const int& a_value)
+        {
+            sum += a_value * 10;
+            return Status::Continue;
+        });
+        dispatcher.Dispatch(1);
+        dispatcher.Enqueue(2);
+        dispatcher.Flush();
+        REQUIRE(dispatcher.Remove(listener));
+        dispatcher.DispatchParallel(3);
+        REQUIRE(dispatcher.Compact() == 1);
+    }
+    REQUIRE(sum == 11 + 22 + 30);
+}
+
 //--------------------------------------------------------------
 TEST_CASE("Test Dispatcher Filter", "[dispatcher][filter]")
 {
@@ -0,0 +1,141 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <simple/event/event_bus.h>
+#include <catch2/catch.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Simple::Event;
+using namespace std;
+
+//--------------------------------------------------------------
+namespace
+{
+    struct MouseMoved
+    {
+        int m_x = 0;
+        int m_y = 0;
+    };
+
+    struct KeyPressed
+    {
+        string m_key;
+    };
+
+    template<int Index>
+    struct IndexedEvent
+    {
+        int m_value = Index;
+    };
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test EventBus Dispatch", "[event_bus][dispatch]")
+{
+    EventBus bus;
+    vector<string> invoked;
+    EventBus::Listener<MouseMoved> mouseListener = bus.Register<MouseMoved>([&invoked](const MouseMoved& a_event)
+    {
+        invoked.push_back("mouse " + to_string(a_event.m_x) + " " + to_string(a_event.m_y));
+        return Status::Continue;
+    });
+    EventBus::Connection<KeyPressed> keyConnection = bus.Connect<KeyPressed>([&invoked](const KeyPressed& a_event)
+    {
+        invoked.push_back("key " + a_event.m_key);
+        return Status::Consumed;
+    });
+    EventBus::Listener<KeyPressed> keyListener = bus.Register<KeyPressed>([&invoked](const KeyPressed&)
+    {
+        invoked.push_back("never");
+        return Status::Continue;
+    }, 1);
+
+    // Events are only sent to listeners for their type.
+    bus.Dispatch(MouseMoved{ 1, 2 });
+    bus.Dispatch(KeyPressed{ "a" });
+    REQUIRE(invoked == vector<string>{ "mouse 1 2", "key a" });
+
+    // Types without listeners have no dispatcher.
+    REQUIRE(bus.Find<IndexedEvent<0>>() == nullptr);
+    bus.Dispatch(IndexedEvent<0>());
+    REQUIRE(bus.Find<IndexedEvent<0>>() == nullptr);
+    REQUIRE(bus.Find<MouseMoved>() == &bus.Get<MouseMoved>());
+
+    // Removing listeners for the type they were registered with.
+    REQUIRE(bus.Remove<MouseMoved>(mouseListener));
+    REQUIRE(!bus.Remove<MouseMoved>(mouseListener));
+    REQUIRE(!bus.Remove<IndexedEvent<0>>(EventBus::Listener<IndexedEvent<0>>()));
+    REQUIRE(bus.Remove<KeyPressed>(keyConnection));
+    invoked.clear();
+    bus.Dispatch(MouseMoved{ 1, 2 });
+    bus.Dispatch(KeyPressed{ "b" });
+    REQUIRE(invoked == vector<string>{ "never" });
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test EventBus Types", "[event_bus][types]")
+{
+    // Each type has its own index, shared by every bus.
+    REQUIRE(EventBus::TypeIndex<MouseMoved>() != EventBus::TypeIndex<KeyPressed>());
+    REQUIRE(EventBus::TypeIndex<MouseMoved>() == EventBus::TypeIndex<MouseMoved>());
+
+    EventBus busA;
+    EventBus busB;
+    int sum = 0;
+    EventBus::Listener<IndexedEvent<1>> listenerA = busA.Register<IndexedEvent<1>>([&sum](const IndexedEvent<1>& a_event)
+    {
+        sum += a_event.m_value;
+        return Status::Continue;
+    });
+    EventBus::Listener<IndexedEvent<2>> listenerB = busB.Register<IndexedEvent<2>>([&sum](const IndexedEvent<2>& a_event)
+    {
+        sum += a_event.m_value * 10;
+        return Status::Continue;
+    });
+    busA.Dispatch(IndexedEvent<1>());
+    busA.Dispatch(IndexedEvent<2>());
+    busB.Dispatch(IndexedEvent<1>());
+    busB.Dispatch(IndexedEvent<2>());
+    REQUIRE(sum == 21);
+
+    // The dispatcher of a type gives access to its full interface.
+    busA.Get<IndexedEvent<1>>().Enqueue(IndexedEvent<1>());
+    busA.Get<IndexedEvent<1>>().Flush();
+    REQUIRE(sum == 22);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test EventBus Thread", "[event_bus][thread]")
+{
+    EventBus bus;
+    atomic<int> count = { 0 };
+
+    // Create dispatchers while dispatching events of other types.
+    thread registering([&bus, &count]()
+    {
+        EventBus::Listener<IndexedEvent<3>> listener3 = bus.Register<IndexedEvent<3>>([&count](const IndexedEvent<3>&)
+        {
+            ++count;
+            return Status::Continue;
+        });
+        EventBus::Listener<IndexedEvent<4>> listener4 = bus.Register<IndexedEvent<4>>([&count](const IndexedEvent<4>&)
+        {
+            ++count;
+            return Status::Continue;
+        });
+    });
+    for (int i = 0; i < 1000; ++i)
+    {
+        bus.Dispatch(IndexedEvent<3>());
+        bus.Dispatch(IndexedEvent<4>());
+    }
+    registering.join();
+    REQUIRE(count <= 2000);
+}
@@ -0,0 +1,82 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <simple/event/executor.h>
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Simple::Event;
+using namespace std;
+
+//--------------------------------------------------------------
+TEST_CASE("Test ThreadPool Execute", "[executor][thread_pool]")
+{
+    const int numTasks = 1000;
+    atomic<int> executedCount = { 0 };
+    {
+        ThreadPool threadPool(4);
+        REQUIRE(threadPool.ThreadCount() == 4);
+        for (int i = 0; i < numTasks; ++i)
+        {
+            threadPool.Execute([&executedCount]()
+            {
+                ++executedCount;
+            });
+        }
+    }
+
+    // Destroying the pool runs all remaining tasks.
+    REQUIRE(executedCount == numTasks);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test ThreadPool Order", "[executor][thread_pool]")
+{
+    // Tasks run in order when there is a single worker thread.
+    vector<int> executed;
+    thread::id workerId;
+    {
+        ThreadPool threadPool(0);
+        REQUIRE(threadPool.ThreadCount() == 1);
+        for (int i = 0; i < 100; ++i)
+        {
+            threadPool.Execute([&executed, &workerId, i]()
+            {
+                workerId = this_thread::get_id();
+                executed.push_back(i);
+            });
+        }
+    }
+
+    REQUIRE(workerId != this_thread::get_id());
+    REQUIRE(executed.size() == 100);
+    for (int i = 0; i < 100; ++i)
+    {
+        REQUIRE(executed[i] == i);
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test ThreadPool Default", "[executor][thread_pool]")
+{
+    ThreadPool& threadPool = ThreadPool::Default();
+    REQUIRE(&threadPool == &ThreadPool::Default());
+    REQUIRE(threadPool.ThreadCount() >= 1);
+
+    atomic<bool> executed = { false };
+    threadPool.Execute([&executed]()
+    {
+        executed = true;
+    });
+    while (!executed)
+    {
+        this_thread::yield();
+    }
+}
@@ -0,0 +1,140 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <simple/event/hazard_pointer.h>
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Simple::Event;
+using namespace std;
+
+//--------------------------------------------------------------
+namespace
+{
+    //----------------------------------------------------------
+    struct LifetimeCounter
+    {
+        LifetimeCounter(atomic<int>& a_alive) : m_alive(a_alive) { ++m_alive; }
+        ~LifetimeCounter() { --m_alive; }
+
+        atomic<int>& m_alive;
+    };
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test HazardPointer Protect", "[hazard_pointer][protect]")
+{
+    atomic<int> alive = { 0 };
+    atomic<LifetimeCounter*> source = { new LifetimeCounter(alive) };
+    vector<LifetimeCounter*> retired;
+
+    {
+        HazardPointer hazardPointer;
+        LifetimeCounter* protectedCounter = hazardPointer.Protect(source);
+        REQUIRE(protectedCounter == source.load());
+
+        // Retired objects are not deleted while they are protected.
+        retired.push_back(source.exchange(new LifetimeCounter(alive)));
+        HazardPointer::Reclaim(retired);
+        REQUIRE(retired.size() == 1);
+        REQUIRE(alive == 2);
+
+        // Resetting the hazard pointer allows them to be deleted.
+        hazardPointer.Reset();
+        HazardPointer::Reclaim(retired);
+        REQUIRE(retired.empty());
+        REQUIRE(alive == 1);
+
+        // Destroying the hazard pointer also stops protecting them.
+        REQUIRE(hazardPointer.Protect(source) == source.load());
+    }
+    retired.push_back(source.exchange(nullptr));
+    HazardPointer::Reclaim(retired);
+    REQUIRE(retired.empty());
+    REQUIRE(alive == 0);
+
+    // Null pointers may be protected.
+    HazardPointer hazardPointer;
+    REQUIRE(hazardPointer.Protect(source) == nullptr);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test HazardPointer Nested", "[hazard_pointer][nested]")
+{
+    atomic<int> alive = { 0 };
+    atomic<LifetimeCounter*> source1 = { new LifetimeCounter(alive) };
+    atomic<LifetimeCounter*> source2 = { new LifetimeCounter(alive) };
+    vector<LifetimeCounter*> retired;
+
+    HazardPointer hazardPointer1;
+    hazardPointer1.Protect(source1);
+    {
+        HazardPointer hazardPointer2;
+        hazardPointer2.Protect(source2);
+        retired.push_back(source1.exchange(nullptr));
+        retired.push_back(source2.exchange(nullptr));
+        HazardPointer::Reclaim(retired);
+        REQUIRE(retired.size() == 2);
+    }
+    HazardPointer::Reclaim(retired);
+    REQUIRE(retired.size() == 1);
+
+    hazardPointer1.Reset();
+    HazardPointer::Reclaim(retired);
+    REQUIRE(retired.empty());
+    REQUIRE(alive == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test HazardPointer Thread", "[hazard_pointer][thread]")
+{
+    atomic<int> alive = { 0 };
+    atomic<LifetimeCounter*> source = { new LifetimeCounter(alive) };
+    atomic<bool> finished = { false };
+    atomic<uint32_t> failures = { 0 };
+
+    // Readers keep checking the object they protect is still alive.
+    vector<thread> readers;
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&source, &finished, &failures]()
+        {
+            while (!finished)
+            {
+                HazardPointer hazardPointer;
+                LifetimeCounter* counter = hazardPointer.Protect(source);
+                if (!counter || counter->m_alive <= 0)
+                {
+                    ++failures;
+                }
+            }
+        });
+    }
+
+    // The writer keeps replacing the object and reclaiming the old.
+    vector<LifetimeCounter*> retired;
+    for (int i = 0; i < 10000; ++i)
+    {
+        retired.push_back(source.exchange(new LifetimeCounter(alive)));
+        HazardPointer::Reclaim(retired);
+    }
+    finished = true;
+    for (thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    HazardPointer::Reclaim(retired);
+    REQUIRE(retired.empty());
+    REQUIRE(failures == 0);
+    REQUIRE(alive == 1);
+    delete source.exchange(nullptr);
+    REQUIRE(alive == 0);
+}
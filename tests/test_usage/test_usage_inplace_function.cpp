@@ -0,0 +1,149 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <simple/event/inplace_function.h>
+#include <catch2/catch.hpp>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+using namespace Simple::Event;
+using namespace std;
+
+//--------------------------------------------------------------
+namespace
+{
+    //----------------------------------------------------------
+    int TestFreeFunction(const int& a_int)
+    {
+        return a_int * 2;
+    }
+
+    //----------------------------------------------------------
+    struct LifetimeCounter
+    {
+        LifetimeCounter(int& a_alive) : m_alive(a_alive) { ++m_alive; }
+        LifetimeCounter(const LifetimeCounter& a_other) : m_alive(a_other.m_alive) { ++m_alive; }
+        ~LifetimeCounter() { --m_alive; }
+
+        int operator()(const int& a_int) const { return a_int + m_alive; }
+
+        int& m_alive;
+    };
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test InplaceFunction Empty", "[inplace_function][empty]")
+{
+    using TestFunction = InplaceFunction<int(const int&)>;
+    TestFunction function;
+    REQUIRE(!function);
+    REQUIRE_THROWS_AS(function(1), bad_function_call);
+
+    int(*nullFunction)(const int&) = nullptr;
+    TestFunction nullPointer = nullFunction;
+    REQUIRE(!nullPointer);
+
+    TestFunction freeFunction = TestFreeFunction;
+    REQUIRE(freeFunction);
+    freeFunction = nullptr;
+    REQUIRE(!freeFunction);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test InplaceFunction Call", "[inplace_function][call]")
+{
+    using TestFunction = InplaceFunction<int(const int&)>;
+    TestFunction freeFunction = TestFreeFunction;
+    REQUIRE(freeFunction(9) == 18);
+
+    int offset = 1;
+    TestFunction lambda = [&offset](const int& a_int)
+    {
+        return a_int + offset;
+    };
+    REQUIRE(lambda(9) == 10);
+    offset = 2;
+    REQUIRE(lambda(9) == 11);
+
+    // Results convertible to the signature are allowed.
+    TestFunction converted = [](int a_int) -> short
+    {
+        return static_cast<short>(a_int);
+    };
+    REQUIRE(converted(9) == 9);
+
+    // Void signatures discard any result.
+    InplaceFunction<void()> discarded = []() { return 9; };
+    discarded();
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test InplaceFunction Copy Move", "[inplace_function][copy]")
+{
+    using TestFunction = InplaceFunction<int(const int&)>;
+    int alive = 0;
+    {
+        TestFunction function = LifetimeCounter(alive);
+        REQUIRE(alive == 1);
+
+        TestFunction copied = function;
+        REQUIRE(alive == 2);
+        REQUIRE(copied(0) == 2);
+
+        TestFunction moved = move(function);
+        REQUIRE(!function);
+        REQUIRE(alive == 2);
+
+        copied = nullptr;
+        REQUIRE(alive == 1);
+
+        copied = moved;
+        REQUIRE(alive == 2);
+
+        moved = TestFunction(TestFreeFunction);
+        REQUIRE(alive == 1);
+        REQUIRE(moved(9) == 18);
+    }
+    REQUIRE(alive == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test InplaceFunction Move Only", "[inplace_function][move]")
+{
+    using TestFunction = InplaceFunction<int(const int&), 4 * sizeof(void*), false>;
+    static_assert(!is_copy_constructible<TestFunction>::value, "Should be move-only");
+    static_assert(!is_copy_assignable<TestFunction>::value, "Should be move-only");
+    static_assert(is_move_constructible<TestFunction>::value, "Should be movable");
+
+    unique_ptr<int> value(new int(9));
+    TestFunction function = [value = move(value)](const int& a_int)
+    {
+        return *value + a_int;
+    };
+    REQUIRE(function(1) == 10);
+
+    TestFunction moved = move(function);
+    REQUIRE(!function);
+    REQUIRE(moved(2) == 11);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test InplaceFunction Capacity", "[inplace_function][capacity]")
+{
+    // Captures that exceed the capacity are rejected at compile
+    // time, so just check that larger capacities store them.
+    string first = "Haggis";
+    string second = "Neeps";
+    InplaceFunction<size_t(), 2 * sizeof(string)> function = [first, second]()
+    {
+        return first.size() + second.size();
+    };
+    REQUIRE(function() == 11);
+    REQUIRE(sizeof(function) >= 2 * sizeof(string));
+}
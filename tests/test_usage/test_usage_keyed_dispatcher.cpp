@@ -0,0 +1,169 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <simple/event/keyed_dispatcher.h>
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Simple::Event;
+using namespace std;
+
+//--------------------------------------------------------------
+namespace
+{
+    //----------------------------------------------------------
+    KeyedDispatcher<int, int>::Callable TestListener(vector<int>& a_invoked,
+                                                     int a_id,
+                                                     int a_consumeId = -1)
+    {
+        return [&a_invoked, a_id, a_consumeId](const int& a_value)
+        {
+            a_invoked.push_back(a_id);
+            return a_value == a_consumeId ? Status::Consumed : Status::Continue;
+        };
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test KeyedDispatcher Routing", "[keyed_dispatcher][routing]")
+{
+    KeyedDispatcher<string, int> dispatcher;
+    vector<string> invoked;
+    KeyedDispatcher<string, int>::Listener listenerA = dispatcher.Register("a", [&invoked](const int&)
+    {
+        invoked.push_back("a");
+        return Status::Continue;
+    });
+    KeyedDispatcher<string, int>::Connection connectionB = dispatcher.Connect("b", [&invoked](const int&)
+    {
+        invoked.push_back("b");
+        return Status::Continue;
+    });
+
+    // Only listeners registered with the key are invoked.
+    dispatcher.Dispatch("a", 0);
+    REQUIRE(invoked == vector<string>{ "a" });
+    dispatcher.Dispatch("b", 0);
+    REQUIRE(invoked == vector<string>{ "a", "b" });
+    dispatcher.Dispatch("c", 0);
+    REQUIRE(invoked == vector<string>{ "a", "b" });
+
+    // Removing requires the key that the listener was registered with.
+    REQUIRE(!dispatcher.Remove("b", listenerA));
+    REQUIRE(dispatcher.Remove("a", listenerA));
+    REQUIRE(!dispatcher.Remove("a", listenerA));
+    dispatcher.Dispatch("a", 0);
+    REQUIRE(invoked == vector<string>{ "a", "b" });
+
+    connectionB.Disconnect();
+    dispatcher.Dispatch("b", 0);
+    REQUIRE(invoked == vector<string>{ "a", "b" });
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test KeyedDispatcher Wildcard", "[keyed_dispatcher][wildcard]")
+{
+    // A single bucket, so all keys collide.
+    KeyedDispatcher<int, int> dispatcher(1);
+    vector<int> invoked;
+    KeyedDispatcher<int, int>::Listener listener1 = dispatcher.Register(1, TestListener(invoked, 1), 1);
+    KeyedDispatcher<int, int>::Listener listener2 = dispatcher.Register(2, TestListener(invoked, 2), 0);
+    KeyedDispatcher<int, int>::Listener listener3 = dispatcher.Register(1, TestListener(invoked, 3), -1);
+    KeyedDispatcher<int, int>::Listener wildcard4 = dispatcher.RegisterWildcard(TestListener(invoked, 4, 4), 0);
+    KeyedDispatcher<int, int>::Listener wildcard5 = dispatcher.RegisterWildcard(TestListener(invoked, 5), 1);
+
+    // Keyed and wildcard listeners are merged by sort index, with
+    // keyed listeners first if they share a sort index.
+    dispatcher.Dispatch(1, 0);
+    REQUIRE(invoked == vector<int>{ 3, 4, 1, 5 });
+
+    invoked.clear();
+    dispatcher.Dispatch(2, 0);
+    REQUIRE(invoked == vector<int>{ 2, 4, 5 });
+
+    invoked.clear();
+    dispatcher.Dispatch(3, 0);
+    REQUIRE(invoked == vector<int>{ 4, 5 });
+
+    // Consuming the event stops lower priority listeners.
+    invoked.clear();
+    dispatcher.Dispatch(1, 4);
+    REQUIRE(invoked == vector<int>{ 3, 4 });
+
+    REQUIRE(dispatcher.RemoveWildcard(wildcard4));
+    REQUIRE(!dispatcher.RemoveWildcard(wildcard4));
+    invoked.clear();
+    dispatcher.Dispatch(1, 4);
+    REQUIRE(invoked == vector<int>{ 3, 1, 5 });
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test KeyedDispatcher Prune", "[keyed_dispatcher][prune]")
+{
+    KeyedDispatcher<int, int> dispatcher(4);
+    vector<int> invoked;
+    vector<KeyedDispatcher<int, int>::Listener> listeners;
+    for (int i = 0; i < 16; ++i)
+    {
+        listeners.push_back(dispatcher.Register(i, TestListener(invoked, i)));
+    }
+    REQUIRE(dispatcher.Prune() == 0);
+
+    // Keys with no listeners left are dropped.
+    listeners.resize(8);
+    REQUIRE(dispatcher.Prune() == 8);
+    REQUIRE(dispatcher.Prune() == 0);
+    for (int i = 0; i < 16; ++i)
+    {
+        dispatcher.Dispatch(i, 0);
+    }
+    REQUIRE(invoked == vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7 });
+
+    // Pruned keys can be registered with again.
+    invoked.clear();
+    KeyedDispatcher<int, int>::Listener listener = dispatcher.Register(12, TestListener(invoked, 12));
+    dispatcher.Dispatch(12, 0);
+    REQUIRE(invoked == vector<int>{ 12 });
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test KeyedDispatcher Thread", "[keyed_dispatcher][thread]")
+{
+    KeyedDispatcher<int, int> dispatcher(8);
+    atomic<int> count = { 0 };
+    KeyedDispatcher<int, int>::Listener wildcard = dispatcher.RegisterWildcard([&count](const int&)
+    {
+        ++count;
+        return Status::Continue;
+    });
+
+    // Register, release and prune keys while dispatching events.
+    thread registering([&dispatcher]()
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            KeyedDispatcher<int, int>::Listener listener = dispatcher.Register(i % 64, [](const int&)
+            {
+                return Status::Continue;
+            });
+            if (i % 16 == 0)
+            {
+                dispatcher.Prune();
+            }
+        }
+    });
+    for (int i = 0; i < 1000; ++i)
+    {
+        dispatcher.Dispatch(i % 64, i);
+    }
+    registering.join();
+    REQUIRE(count == 1000);
+}
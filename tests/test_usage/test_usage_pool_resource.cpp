@@ -0,0 +1,151 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <simple/event/dispatcher.h>
+#include <simple/event/pool_resource.h>
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace Simple::Event;
+using namespace std;
+
+//--------------------------------------------------------------
+namespace
+{
+    //----------------------------------------------------------
+    class CountingResource : public pmr::memory_resource
+    {
+    public:
+        size_t m_allocations = 0;
+        size_t m_outstanding = 0;
+
+    private:
+        void* do_allocate(size_t a_bytes, size_t a_alignment) override
+        {
+            ++m_allocations;
+            ++m_outstanding;
+            return pmr::new_delete_resource()->allocate(a_bytes, a_alignment);
+        }
+
+        void do_deallocate(void* a_block, size_t a_bytes, size_t a_alignment) override
+        {
+            --m_outstanding;
+            pmr::new_delete_resource()->deallocate(a_block, a_bytes, a_alignment);
+        }
+
+        bool do_is_equal(const pmr::memory_resource& a_other) const noexcept override
+        {
+            return this == &a_other;
+        }
+    };
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test PoolResource Blocks", "[pool_resource][blocks]")
+{
+    CountingResource upstream;
+    {
+        PoolResource pool(256, 4096, &upstream);
+        REQUIRE(pool.MaxBlockSize() == 256);
+        REQUIRE(pool.UpstreamBytes() == 0);
+
+        // Blocks are aligned to (at least) a cache line.
+        void* small = pool.allocate(24, 8);
+        void* large = pool.allocate(200, 64);
+        REQUIRE(reinterpret_cast<uintptr_t>(small) % 64 == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(large) % 64 == 0);
+        REQUIRE(small != large);
+        REQUIRE(upstream.m_allocations == 1);
+        REQUIRE(pool.UpstreamBytes() == 4096);
+
+        // Deallocated blocks are reused by requests of the same size.
+        pool.deallocate(small, 24, 8);
+        REQUIRE(pool.allocate(64, 8) == small);
+        pool.deallocate(large, 200, 64);
+        REQUIRE(pool.allocate(129, 16) == large);
+
+        // Larger requests are passed to the upstream resource.
+        void* huge = pool.allocate(1000, 8);
+        REQUIRE(upstream.m_allocations == 2);
+        pool.deallocate(huge, 1000, 8);
+        REQUIRE(upstream.m_outstanding == 1);
+
+        // More chunks are taken from the upstream when needed.
+        vector<void*> blocks;
+        for (int i = 0; i < 100; ++i)
+        {
+            blocks.push_back(pool.allocate(256, 8));
+        }
+        REQUIRE(upstream.m_allocations > 2);
+        for (void* block : blocks)
+        {
+            pool.deallocate(block, 256, 8);
+        }
+    }
+    REQUIRE(upstream.m_outstanding == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test PoolResource Dispatcher", "[pool_resource][dispatcher]")
+{
+    CountingResource upstream;
+    {
+        PoolResource pool(4096, 64 * 1024, &upstream);
+        BasicDispatcher<InplacePolicy<>, int> dispatcher(&pool);
+        int sum = 0;
+
+        // Churning listeners reuses blocks, rather than taking more.
+        for (int i = 0; i < 100; ++i)
+        {
+            vector<BasicDispatcher<InplacePolicy<>, int>::Listener> listeners;
+            for (int j = 0; j < 100; ++j)
+            {
+                listeners.push_back(dispatcher.Register([&sum](const int& a_value)
+                {
+                    sum += a_value;
+                    return Status::Continue;
+                }));
+            }
+            dispatcher.Dispatch(1);
+            listeners.clear();
+            dispatcher.Compact();
+        }
+        REQUIRE(sum == 100 * 100);
+        REQUIRE(upstream.m_allocations < 10);
+    }
+    REQUIRE(upstream.m_outstanding == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test PoolResource Thread", "[pool_resource][thread]")
+{
+    PoolResource pool;
+    vector<thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&pool]()
+        {
+            vector<void*> blocks;
+            for (int j = 0; j < 1000; ++j)
+            {
+                blocks.push_back(pool.allocate(64 + j % 256, 8));
+            }
+            for (int j = 0; j < 1000; ++j)
+            {
+                pool.deallocate(blocks[j], 64 + j % 256, 8);
+            }
+        });
+    }
+    for (thread& thread : threads)
+    {
+        thread.join();
+    }
+    REQUIRE(pool.UpstreamBytes() > 0);
+}
@@ -0,0 +1,148 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <simple/event/sharded_dispatcher.h>
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Simple::Event;
+using namespace std;
+
+//--------------------------------------------------------------
+namespace
+{
+    //----------------------------------------------------------
+    ShardedDispatcher<int>::Callable TestListener(vector<int>& a_invoked,
+                                                  int a_id,
+                                                  int a_consumeId = -1)
+    {
+        return [&a_invoked, a_id, a_consumeId](const int& a_value)
+        {
+            a_invoked.push_back(a_id);
+            return a_value == a_consumeId ? Status::Consumed : Status::Continue;
+        };
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test ShardedDispatcher Order", "[sharded_dispatcher][order]")
+{
+    REQUIRE(ShardedDispatcher<int>(0).ShardCount() == 1);
+    REQUIRE(ShardedDispatcher<int>(1000).ShardCount() == ShardedDispatcher<int>::MaxShardCount);
+
+    // Register listeners from several threads (so with several
+    // shards), and the same listeners with a single dispatcher.
+    ShardedDispatcher<int> sharded(4);
+    Dispatcher<int> single;
+    vector<int> shardedInvoked;
+    vector<int> singleInvoked;
+    vector<ShardedDispatcher<int>::Listener> listeners;
+    for (int i = 0; i < 32; ++i)
+    {
+        const int sortIndex = (i * 7) % 5 - 2;
+        thread registering([&, i, sortIndex]()
+        {
+            listeners.push_back(sharded.Register(TestListener(shardedInvoked, i, i), sortIndex));
+            listeners.push_back(single.Register(TestListener(singleInvoked, i, i), sortIndex));
+        });
+        registering.join();
+    }
+
+    // Listeners are invoked in exactly the same order.
+    sharded.Dispatch(-1);
+    single.Dispatch(-1);
+    REQUIRE(shardedInvoked.size() == 32);
+    REQUIRE(shardedInvoked == singleInvoked);
+
+    // Consuming the event stops lower priority listeners.
+    shardedInvoked.clear();
+    singleInvoked.clear();
+    sharded.Dispatch(9);
+    single.Dispatch(9);
+    REQUIRE(shardedInvoked.back() == 9);
+    REQUIRE(shardedInvoked == singleInvoked);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test ShardedDispatcher Remove", "[sharded_dispatcher][remove]")
+{
+    ShardedDispatcher<int> dispatcher(2);
+    vector<int> invoked;
+    ShardedDispatcher<int>::Listener listener1;
+    ShardedDispatcher<int>::Connection connection2;
+    thread registering([&]()
+    {
+        listener1 = dispatcher.Register(TestListener(invoked, 1), 1);
+        connection2 = dispatcher.Connect(TestListener(invoked, 2), 0);
+    });
+    registering.join();
+    ShardedDispatcher<int>::Listener listener3 = dispatcher.Register(TestListener(invoked, 3), 0);
+
+    dispatcher.Dispatch(0);
+    REQUIRE(invoked == vector<int>{ 2, 3, 1 });
+
+    // Listeners are removed from whichever shard they were in.
+    REQUIRE(dispatcher.Remove(listener1));
+    REQUIRE(!dispatcher.Remove(listener1));
+    REQUIRE(dispatcher.Remove(listener3));
+    invoked.clear();
+    dispatcher.Dispatch(0);
+    REQUIRE(invoked == vector<int>{ 2 });
+
+    // Listeners of other dispatchers are not removed.
+    Dispatcher<int> other;
+    Dispatcher<int>::Connection connection4 = other.Connect(TestListener(invoked, 4));
+    REQUIRE(!dispatcher.Remove(connection4));
+
+    connection2.Disconnect();
+    invoked.clear();
+    dispatcher.Dispatch(0);
+    REQUIRE(invoked.empty());
+    dispatcher.Compact();
+    REQUIRE(dispatcher.Compact() == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test ShardedDispatcher Thread", "[sharded_dispatcher][thread]")
+{
+    ShardedDispatcher<int> dispatcher(8);
+    atomic<int> count = { 0 };
+    ShardedDispatcher<int>::Listener listener = dispatcher.Register([&count](const int&)
+    {
+        ++count;
+        return Status::Continue;
+    });
+
+    // Register and release listeners on many threads while
+    // dispatching events.
+    vector<thread> threads;
+    for (int t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&dispatcher, t]()
+        {
+            for (int i = 0; i < 250; ++i)
+            {
+                ShardedDispatcher<int>::Connection connection = dispatcher.Connect([](const int&)
+                {
+                    return Status::Continue;
+                }, (t + i) % 3);
+            }
+        });
+    }
+    for (int i = 0; i < 1000; ++i)
+    {
+        dispatcher.Dispatch(i);
+    }
+    for (thread& registering : threads)
+    {
+        registering.join();
+    }
+    REQUIRE(count == 1000);
+}
@@ -0,0 +1,84 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <simple/event/static_dispatcher.h>
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace Simple::Event;
+using namespace std;
+
+//--------------------------------------------------------------
+namespace
+{
+    vector<int> s_invoked;
+
+    //----------------------------------------------------------
+    template<int Id>
+    Status TestListener(const int& a_consumeId)
+    {
+        s_invoked.push_back(Id);
+        return a_consumeId == Id ? Status::Consumed : Status::Continue;
+    }
+
+    //----------------------------------------------------------
+    Status TestStringListener(const string& a_string, const float& a_float)
+    {
+        s_invoked.push_back(static_cast<int>(a_string.size() + a_float));
+        return Status::Continue;
+    }
+
+    //----------------------------------------------------------
+    struct TestClass
+    {
+        static Status TestStaticFunction(const int&)
+        {
+            s_invoked.push_back(0);
+            return Status::Continue;
+        }
+    };
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test StaticDispatcher Priority", "[static_dispatcher][priority]")
+{
+    using TestDispatcher = StaticDispatcher<StaticListener<TestListener<1>>,
+                                            StaticListener<TestListener<2>, 1>,
+                                            StaticListener<TestListener<3>, -1>,
+                                            StaticListener<TestListener<4>>,
+                                            StaticListener<TestClass::TestStaticFunction, -1>>;
+
+    // Listeners are sorted by index, then by the order listed.
+    s_invoked.clear();
+    TestDispatcher::Dispatch(0);
+    REQUIRE(s_invoked == vector<int>{ 3, 0, 1, 4, 2 });
+
+    // Consuming the event stops lower priority listeners.
+    s_invoked.clear();
+    TestDispatcher::Dispatch(1);
+    REQUIRE(s_invoked == vector<int>{ 3, 0, 1 });
+
+    s_invoked.clear();
+    TestDispatcher::Dispatch(3);
+    REQUIRE(s_invoked == vector<int>{ 3 });
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test StaticDispatcher Args", "[static_dispatcher][args]")
+{
+    using TestDispatcher = StaticDispatcher<StaticListener<TestStringListener>>;
+
+    s_invoked.clear();
+    TestDispatcher::Dispatch(string("four"), 1.0f);
+    REQUIRE(s_invoked == vector<int>{ 5 });
+
+    // Dispatchers without any listeners do nothing.
+    StaticDispatcher<>::Dispatch(1);
+    REQUIRE(s_invoked.size() == 1);
+}
@@ -0,0 +1,191 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <simple/event/trace.h>
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Simple::Event;
+using namespace std;
+
+//--------------------------------------------------------------
+namespace
+{
+    //----------------------------------------------------------
+    struct Point
+    {
+        int m_x;
+        int m_y;
+    };
+
+    //----------------------------------------------------------
+    string TracePath(const string& a_name)
+    {
+        return (filesystem::temp_directory_path() / ("simple_event_" + a_name + ".trace")).string();
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Trace Record Replay", "[trace][replay]")
+{
+    const string path = TracePath("record_replay");
+    Dispatcher<Point, string> dispatcher;
+    vector<string> invoked;
+    Dispatcher<Point, string>::Listener listener1 = dispatcher.Register([&invoked](const Point& a_point,
+                                                                                   const string& a_name)
+    {
+        invoked.push_back(a_name + to_string(a_point.m_x + a_point.m_y));
+        return Status::Continue;
+    }, 0);
+    Dispatcher<Point, string>::Listener listener2 = dispatcher.Register([](const Point& a_point,
+                                                                           const string&)
+    {
+        return a_point.m_x < 0 ? Status::Consumed : Status::Continue;
+    }, -1);
+    Dispatcher<Point, string>::Listener listener3 = dispatcher.Register(nullptr, 1);
+
+    // Record events, each dispatched just as Dispatch would.
+    {
+        Recorder<Point, string> recorder(dispatcher, path, 16);
+        recorder.Dispatch({ 1, 2 }, "a");
+        recorder.Dispatch({ -1, 2 }, "b");
+        recorder.Dispatch({ 3, 4 }, "");
+        REQUIRE(recorder.Size() == 3);
+        REQUIRE(invoked == vector<string>{ "a3", "7" });
+    }
+
+    // Records note how each event was delivered.
+    const Replayer<Point, string> replayer(path);
+    REQUIRE(replayer.Size() == 3);
+    const vector<TraceRecord>& records = replayer.Records();
+    REQUIRE(records[0].m_invoked == 2);
+    REQUIRE(!records[0].m_consumed);
+    REQUIRE(records[1].m_invoked == 1);
+    REQUIRE(records[1].m_consumed);
+    REQUIRE(records[1].m_consumerSortIndex == -1);
+    REQUIRE(records[0].m_time <= records[1].m_time);
+    REQUIRE(records[1].m_time <= records[2].m_time);
+
+    // Replaying dispatches the same events, with the same outcome.
+    invoked.clear();
+    REQUIRE(replayer.Replay(dispatcher) == 0);
+    REQUIRE(invoked == vector<string>{ "a3", "7" });
+
+    // Outcomes that differ from the recording are counted.
+    listener2 = nullptr;
+    invoked.clear();
+    REQUIRE(replayer.Replay(dispatcher) == 3);
+    REQUIRE(invoked == vector<string>{ "a3", "b1", "7" });
+
+    Dispatcher<Point, string> other;
+    REQUIRE(replayer.Replay(other) == 3);
+    remove(path.c_str());
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Trace Replay Speed", "[trace][speed]")
+{
+    const string path = TracePath("replay_speed");
+    Dispatcher<int> dispatcher;
+    int sum = 0;
+    Dispatcher<int>::Listener listener = dispatcher.Register([&sum](const int& a_value)
+    {
+        sum += a_value;
+        return Status::Continue;
+    });
+    {
+        Recorder<int> recorder(dispatcher, path);
+        recorder.Dispatch(1);
+        this_thread::sleep_for(chrono::milliseconds(20));
+        recorder.Dispatch(2);
+        recorder.Flush();
+    }
+    REQUIRE(sum == 3);
+
+    // Events are replayed as far apart as they were recorded.
+    const Replayer<int> replayer(path);
+    REQUIRE(replayer.Records()[1].m_time >= chrono::milliseconds(20));
+    const auto start = chrono::steady_clock::now();
+    REQUIRE(replayer.Replay(dispatcher, ReplaySpeed::Original) == 0);
+    REQUIRE(chrono::steady_clock::now() - start >= chrono::milliseconds(20));
+    REQUIRE(sum == 6);
+    REQUIRE(replayer.Replay(dispatcher, ReplaySpeed::Fastest) == 0);
+    REQUIRE(sum == 9);
+    remove(path.c_str());
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Trace Thread", "[trace][thread]")
+{
+    const string path = TracePath("thread");
+    Dispatcher<int> dispatcher;
+    Dispatcher<int>::Listener listener = dispatcher.Register([](const int& a_value)
+    {
+        return a_value % 2 ? Status::Consumed : Status::Continue;
+    });
+
+    // Many threads may record with the same recorder at once.
+    {
+        Recorder<int> recorder(dispatcher, path, 256);
+        vector<thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&recorder, t]()
+            {
+                for (int i = 0; i < 250; ++i)
+                {
+                    recorder.Dispatch(t * 250 + i);
+                }
+            });
+        }
+        for (thread& recording : threads)
+        {
+            recording.join();
+        }
+        REQUIRE(recorder.Size() == 1000);
+    }
+
+    const Replayer<int> replayer(path);
+    REQUIRE(replayer.Size() == 1000);
+    REQUIRE(replayer.Replay(dispatcher) == 0);
+    remove(path.c_str());
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Trace Errors", "[trace][errors]")
+{
+    const string path = TracePath("errors");
+    REQUIRE_THROWS_AS(Replayer<int>(TracePath("missing")), TraceError);
+
+    // Files that are not traces are rejected.
+    FILE* file = fopen(path.c_str(), "wb");
+    REQUIRE(file);
+    fputs("not a trace", file);
+    fclose(file);
+    REQUIRE_THROWS_AS(Replayer<int>(path), TraceError);
+
+    // Traces recorded with another event signature are rejected.
+    Dispatcher<int, int> dispatcher;
+    {
+        Recorder<int, int> recorder(dispatcher, path);
+        recorder.Dispatch(1, 2);
+    }
+    using PairReplayer = Replayer<int, int>;
+    REQUIRE(PairReplayer(path).Size() == 1);
+    REQUIRE_THROWS_AS(Replayer<int>(path), TraceError);
+
+    // Truncated traces are rejected.
+    filesystem::resize_file(path, filesystem::file_size(path) - 1);
+    REQUIRE_THROWS_AS(PairReplayer(path), TraceError);
+    remove(path.c_str());
+}